@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <cstring>
 #include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <optional>
@@ -45,10 +46,14 @@ public:
     Verify,
   };
 
+  // Called by DoMarker() with the name of the marker and the position right after it.
+  using MarkerCallback = std::function<void(const std::string& name, const u8* position)>;
+
 private:
   u8** m_ptr_current;
   u8* m_ptr_end;
   Mode m_mode;
+  MarkerCallback m_marker_callback;
 
 public:
   PointerWrap(u8** ptr, size_t size, Mode mode)
@@ -58,6 +63,7 @@ public:
 
   void SetMeasureMode() { m_mode = Mode::Measure; }
   void SetVerifyMode() { m_mode = Mode::Verify; }
+  void SetMarkerCallback(MarkerCallback callback) { m_marker_callback = std::move(callback); }
   bool IsReadMode() const { return m_mode == Mode::Read; }
   bool IsWriteMode() const { return m_mode == Mode::Write; }
   bool IsMeasureMode() const { return m_mode == Mode::Measure; }
@@ -313,6 +319,9 @@ public:
           prevName, cookie, cookie, arbitraryNumber, arbitraryNumber);
       SetMeasureMode();
     }
+
+    if (m_marker_callback)
+      m_marker_callback(prevName, *m_ptr_current);
   }
 
   template <typename T, typename Functor>
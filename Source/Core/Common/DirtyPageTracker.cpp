@@ -0,0 +1,127 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/DirtyPageTracker.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Common/Logging/Log.h"
+
+namespace Common
+{
+#ifdef __linux__
+// See Documentation/admin-guide/mm/soft-dirty.rst and pagemap.rst in the kernel sources.
+constexpr u64 PAGEMAP_SOFT_DIRTY_BIT = u64{1} << 55;
+constexpr char CLEAR_SOFT_DIRTY_COMMAND = '4';
+
+// Number of pagemap entries read at once.
+constexpr std::size_t PAGEMAP_CHUNK_ENTRIES = 0x10000;
+
+DirtyPageTracker::DirtyPageTracker()
+{
+  if (sysconf(_SC_PAGESIZE) != static_cast<long>(TRACKED_PAGE_SIZE))
+  {
+    INFO_LOG_FMT(MEMMAP, "Dirty page tracking is unavailable: the host page size isn't 4 KiB");
+    return;
+  }
+
+  m_pagemap_fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+  m_clear_refs_fd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+  if (m_pagemap_fd < 0 || m_clear_refs_fd < 0)
+  {
+    INFO_LOG_FMT(MEMMAP, "Dirty page tracking is unavailable: /proc/self is not accessible");
+    return;
+  }
+
+  // Kernels built without CONFIG_MEM_SOFT_DIRTY report every page as clean, so check that a write
+  // to shared memory (which is what emulated memory is made of) is actually noticed.
+  void* const page = mmap(nullptr, TRACKED_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (page == MAP_FAILED)
+    return;
+
+  m_is_available = true;
+  std::vector<bool> dirty(2);
+  bool success = Reset() && GetDirtyPages(page, TRACKED_PAGE_SIZE, dirty, 0);
+  *static_cast<volatile u8*>(page) = 1;
+  success = success && GetDirtyPages(page, TRACKED_PAGE_SIZE, dirty, 1);
+  munmap(page, TRACKED_PAGE_SIZE);
+
+  m_is_available = success && !dirty[0] && dirty[1];
+  if (!m_is_available)
+    INFO_LOG_FMT(MEMMAP, "Dirty page tracking is unavailable: soft-dirty bits aren't supported");
+}
+
+DirtyPageTracker::~DirtyPageTracker()
+{
+  if (m_pagemap_fd >= 0)
+    close(m_pagemap_fd);
+  if (m_clear_refs_fd >= 0)
+    close(m_clear_refs_fd);
+}
+
+bool DirtyPageTracker::Reset()
+{
+  if (!m_is_available)
+    return false;
+
+  return write(m_clear_refs_fd, &CLEAR_SOFT_DIRTY_COMMAND, 1) == 1;
+}
+
+bool DirtyPageTracker::GetDirtyPages(const void* pointer, std::size_t size,
+                                     std::vector<bool>& dirty, std::size_t first_page)
+{
+  if (!m_is_available)
+    return false;
+
+  const std::size_t page_count = size / TRACKED_PAGE_SIZE;
+  const std::uintptr_t first_host_page =
+      reinterpret_cast<std::uintptr_t>(pointer) / TRACKED_PAGE_SIZE;
+
+  m_pagemap_entries.resize(std::min(page_count, PAGEMAP_CHUNK_ENTRIES));
+  for (std::size_t i = 0; i < page_count; i += m_pagemap_entries.size())
+  {
+    const std::size_t entries = std::min(page_count - i, m_pagemap_entries.size());
+    const std::size_t bytes = entries * sizeof(u64);
+    const off_t offset = static_cast<off_t>((first_host_page + i) * sizeof(u64));
+    if (pread(m_pagemap_fd, m_pagemap_entries.data(), bytes, offset) !=
+        static_cast<ssize_t>(bytes))
+    {
+      ERROR_LOG_FMT(MEMMAP, "Failed to read the page map at {}", fmt::ptr(pointer));
+      return false;
+    }
+
+    for (std::size_t j = 0; j < entries; ++j)
+    {
+      if (m_pagemap_entries[j] & PAGEMAP_SOFT_DIRTY_BIT)
+        dirty[first_page + i + j] = true;
+    }
+  }
+
+  return true;
+}
+
+#else
+
+DirtyPageTracker::DirtyPageTracker() = default;
+DirtyPageTracker::~DirtyPageTracker() = default;
+
+bool DirtyPageTracker::Reset()
+{
+  return false;
+}
+
+bool DirtyPageTracker::GetDirtyPages(const void*, std::size_t, std::vector<bool>&, std::size_t)
+{
+  return false;
+}
+
+#endif
+}  // namespace Common
@@ -0,0 +1,50 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// Finds out which pages of host memory were written since the last call to Reset().
+//
+// This is implemented with the soft-dirty bits of the Linux kernel, which are tracked per page
+// table entry. When the same memory is mapped several times, every view that might have been
+// written through must be queried. On other hosts, or if the kernel doesn't support soft-dirty
+// bits, IsAvailable() returns false.
+class DirtyPageTracker final
+{
+public:
+  static constexpr std::size_t TRACKED_PAGE_SIZE = 0x1000;
+
+  DirtyPageTracker();
+  ~DirtyPageTracker();
+  DirtyPageTracker(const DirtyPageTracker&) = delete;
+  DirtyPageTracker(DirtyPageTracker&&) = delete;
+  DirtyPageTracker& operator=(const DirtyPageTracker&) = delete;
+  DirtyPageTracker& operator=(DirtyPageTracker&&) = delete;
+
+  bool IsAvailable() const { return m_is_available; }
+
+  // Starts a new tracking period. Note that this applies to the whole process: the kernel walks
+  // every mapping of the process to write-protect its pages, so the cost grows with all of the
+  // memory Dolphin has mapped (not only emulated memory), and the next write to each of those pages
+  // takes a minor page fault. Avoid calling this more often than needed.
+  bool Reset();
+
+  // Sets dirty[first_page + i] for every page i of [pointer, pointer + size) that was written since
+  // the last Reset(). Other elements are left unchanged. The range must be page aligned.
+  bool GetDirtyPages(const void* pointer, std::size_t size, std::vector<bool>& dirty,
+                     std::size_t first_page);
+
+private:
+  int m_pagemap_fd = -1;
+  int m_clear_refs_fd = -1;
+  bool m_is_available = false;
+  std::vector<u64> m_pagemap_entries;
+};
+}  // namespace Common
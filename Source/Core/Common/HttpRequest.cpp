@@ -186,9 +186,10 @@ void HttpRequest::Impl::FollowRedirects(long max)
 
 std::string HttpRequest::Impl::GetHeaderValue(std::string_view name) const
 {
+  // Header names are case-insensitive, and HTTP/2 servers send them in lowercase.
   for (const auto& [key, value] : m_response_headers)
   {
-    if (key == name)
+    if (Common::CaseInsensitiveEquals(key, name))
       return value.value();
   }
 
@@ -0,0 +1,182 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// A lockless thread-safe, multiple producer, single consumer queue.
+//
+// Elements are kept in a bounded ring. Producers claim a cell by advancing the tail with a CAS, and
+// the consumer reads cells in order without taking any locks. If the ring is full, producers fall
+// back to a locked overflow list instead of blocking, so a stalled consumer can never block them.
+// The elements pushed by any one producer are always popped in the order they were pushed.
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+struct MPSCQueueStats
+{
+  // Number of times a producer had to retry because another producer claimed a cell first.
+  u64 contention = 0;
+  // Number of elements that went to the overflow list because the ring was full.
+  u64 overflows = 0;
+  // Largest number of elements seen waiting in the ring, or in the overflow list, on a pop.
+  std::size_t max_depth = 0;
+};
+
+template <typename T, std::size_t Capacity>
+class MPSCQueue final
+{
+  static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+  static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+public:
+  MPSCQueue()
+  {
+    for (std::size_t i = 0; i < Capacity; ++i)
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  // Safe from any thread.
+  void Push(const T& value)
+  {
+    // Once elements have gone to the overflow list, everything pushed after them has to follow
+    // until the consumer has caught up, or they could be popped out of order.
+    if (m_overflow_active.load(std::memory_order_acquire))
+    {
+      std::lock_guard lk(m_overflow_lock);
+      if (m_overflow_active.load(std::memory_order_relaxed))
+      {
+        PushOverflow(value);
+        return;
+      }
+    }
+
+    std::size_t position = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+      Cell& cell = m_cells[position % Capacity];
+      const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence - position);
+      if (diff == 0)
+      {
+        if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          cell.value = value;
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return;
+        }
+        m_contention.fetch_add(1, std::memory_order_relaxed);
+      }
+      else if (diff < 0)
+      {
+        std::lock_guard lk(m_overflow_lock);
+        m_overflow_active.store(true, std::memory_order_release);
+        PushOverflow(value);
+        return;
+      }
+      else
+      {
+        position = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // The following are only safe from the "consumer thread":
+  // Size() is approximate while producers are pushing.
+  std::size_t Size() const
+  {
+    const std::size_t ring_size = m_tail.load(std::memory_order_acquire) - m_head;
+    if (!m_overflow_active.load(std::memory_order_acquire))
+      return ring_size;
+    std::lock_guard lk(m_overflow_lock);
+    return ring_size + m_overflow.size() - m_overflow_read_index;
+  }
+  bool Empty() const { return Size() == 0; }
+
+  bool Pop(T& result)
+  {
+    Cell& cell = m_cells[m_head % Capacity];
+    if (cell.sequence.load(std::memory_order_acquire) == m_head + 1)
+    {
+      UpdateMaxDepth(m_tail.load(std::memory_order_relaxed) - m_head);
+      result = cell.value;
+      cell.sequence.store(m_head + Capacity, std::memory_order_release);
+      ++m_head;
+      return true;
+    }
+
+    if (!m_overflow_active.load(std::memory_order_acquire))
+      return false;
+
+    std::lock_guard lk(m_overflow_lock);
+    // Cells claimed before anything went to the overflow list have to be popped first. Since
+    // producers claim cells before taking the lock, they are all visible here.
+    if (m_head != m_tail.load(std::memory_order_acquire))
+      return false;
+
+    UpdateMaxDepth(m_overflow.size() - m_overflow_read_index);
+    result = m_overflow[m_overflow_read_index++];
+    if (m_overflow_read_index == m_overflow.size())
+    {
+      m_overflow.clear();
+      m_overflow_read_index = 0;
+      m_overflow_active.store(false, std::memory_order_release);
+    }
+    return true;
+  }
+
+  MPSCQueueStats GetStats() const
+  {
+    return {.contention = m_contention.load(std::memory_order_relaxed),
+            .overflows = m_overflows.load(std::memory_order_relaxed),
+            .max_depth = m_max_depth.load(std::memory_order_relaxed)};
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  void PushOverflow(const T& value)
+  {
+    m_overflow.push_back(value);
+    m_overflows.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void UpdateMaxDepth(std::size_t depth)
+  {
+    if (depth > m_max_depth.load(std::memory_order_relaxed))
+      m_max_depth.store(depth, std::memory_order_relaxed);
+  }
+
+  std::array<Cell, Capacity> m_cells;
+
+  // Written by the consumer only.
+  alignas(64) std::size_t m_head = 0;
+  std::atomic<std::size_t> m_max_depth = 0;
+
+  // Written by the producers.
+  alignas(64) std::atomic<std::size_t> m_tail = 0;
+  std::atomic<u64> m_contention = 0;
+  std::atomic<u64> m_overflows = 0;
+
+  alignas(64) std::atomic_bool m_overflow_active = false;
+  mutable std::mutex m_overflow_lock;
+  std::vector<T> m_overflow;
+  std::size_t m_overflow_read_index = 0;
+};
+}  // namespace Common
@@ -0,0 +1,158 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+// A fixed number of worker threads that run functions by priority, 0 being the highest. Functions
+// of the same priority start in the order they were pushed.
+//
+// Only functions of the highest priority may take the last idle worker. However much lower
+// priority work is queued or running, a function of the highest priority then starts as soon as
+// it's pushed, as long as no other function of the highest priority is running.
+template <std::size_t PriorityCount>
+class PriorityWorkerPool final
+{
+public:
+  using FuncType = std::function<void()>;
+
+  PriorityWorkerPool() = default;
+  PriorityWorkerPool(std::string name, std::size_t thread_count)
+  {
+    Reset(std::move(name), thread_count);
+  }
+  ~PriorityWorkerPool() { Shutdown(); }
+
+  PriorityWorkerPool(const PriorityWorkerPool&) = delete;
+  PriorityWorkerPool& operator=(const PriorityWorkerPool&) = delete;
+
+  // Shuts the current workers down (if any) and starts thread_count new ones.
+  // Functions pushed before Reset are run by the new workers.
+  void Reset(std::string name, std::size_t thread_count)
+  {
+    Shutdown();
+
+    std::lock_guard lk{m_mutex};
+    m_stop = false;
+    m_idle_count = thread_count;
+    for (std::size_t i = 0; i < thread_count; ++i)
+      m_threads.emplace_back(&PriorityWorkerPool::ThreadLoop, this, name);
+  }
+
+  void Push(std::size_t priority, FuncType func)
+  {
+    std::lock_guard lk{m_mutex};
+    m_queues[priority].push_back(std::move(func));
+    m_state_changed.notify_all();
+  }
+
+  // Drops the functions of the given priority that haven't started yet.
+  void Cancel(std::size_t priority)
+  {
+    std::lock_guard lk{m_mutex};
+    m_queues[priority].clear();
+    m_state_changed.notify_all();
+  }
+
+  // Blocks until all pushed functions have finished (or were cancelled).
+  // Does nothing if no workers are running.
+  void WaitForCompletion()
+  {
+    std::unique_lock lk{m_mutex};
+    m_state_changed.wait(lk, [&] { return m_threads.empty() || IsIdle(); });
+  }
+
+  // Waits for all pushed functions to finish and stops the workers.
+  void Shutdown()
+  {
+    WaitForCompletion();
+
+    std::vector<std::thread> threads;
+    {
+      std::lock_guard lk{m_mutex};
+      m_stop = true;
+      m_state_changed.notify_all();
+      threads = std::move(m_threads);
+      m_threads.clear();
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+
+private:
+  bool IsIdle() const
+  {
+    if (m_idle_count != m_threads.size())
+      return false;
+    for (const std::deque<FuncType>& queue : m_queues)
+    {
+      if (!queue.empty())
+        return false;
+    }
+    return true;
+  }
+
+  // Returns the queue that an idle worker should take its next function from, if any.
+  std::deque<FuncType>* GetRunnableQueue()
+  {
+    for (std::size_t priority = 0; priority < PriorityCount; ++priority)
+    {
+      if (m_queues[priority].empty())
+        continue;
+
+      if (priority != 0 && m_idle_count <= 1 && m_threads.size() > 1)
+        return nullptr;
+      return &m_queues[priority];
+    }
+    return nullptr;
+  }
+
+  void ThreadLoop(const std::string& name)
+  {
+    Common::SetCurrentThreadName(name.c_str());
+
+    std::unique_lock lk{m_mutex};
+    while (true)
+    {
+      std::deque<FuncType>* queue = nullptr;
+      m_state_changed.wait(lk, [&] {
+        queue = GetRunnableQueue();
+        return queue != nullptr || m_stop;
+      });
+      if (m_stop)
+        return;
+
+      FuncType func = std::move(queue->front());
+      queue->pop_front();
+      --m_idle_count;
+
+      lk.unlock();
+      func();
+      lk.lock();
+
+      ++m_idle_count;
+      m_state_changed.notify_all();
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_state_changed;
+  std::array<std::deque<FuncType>, PriorityCount> m_queues;
+  std::vector<std::thread> m_threads;
+  std::size_t m_idle_count = 0;
+  bool m_stop = false;
+};
+}  // namespace Common
@@ -5,7 +5,13 @@
 
 #include "Core/AchievementManager.h"
 
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <memory>
+#include <span>
+#include <system_error>
+#include <utility>
 
 #include <fmt/format.h>
 
@@ -33,6 +39,7 @@
 #include "Core/HW/VideoInterface.h"
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 #include "DiscIO/Blob.h"
 #include "UICommon/DiscordPresence.h"
@@ -46,6 +53,10 @@
 #include <shlwapi.h>
 #endif  // RC_CLIENT_SUPPORTS_RAINTEGRATION
 
+// Set while rc_client_do_frame runs on the current thread, so that MemoryPeeker knows to serve
+// reads from the memory snapshot.
+static thread_local bool s_evaluating_frame = false;
+
 #ifdef ANDROID
 static const Common::HttpRequest::Headers USER_AGENT_HEADER = {
     {"User-Agent", Common::GetUserAgentStr() + " (Android)"}};
@@ -79,8 +90,9 @@ void AchievementManager::Init(void* hwnd)
                              });
     m_config_changed_callback_id = Config::AddConfigChangedCallback([this] { SetHardcoreMode(); });
     SetHardcoreMode();
-    m_queue.Reset("AchievementManagerQueue");
-    m_image_queue.Reset("AchievementManagerImageQueue");
+    m_request_pool.Reset("AchievementManagerRequests", REQUEST_THREAD_COUNT);
+    m_evaluation_queue.Reset("AchievementManagerEvaluationQueue");
+    m_hash_queue.Reset("AchievementManagerHashQueue");
 
 #ifdef RC_CLIENT_SUPPORTS_RAINTEGRATION
     // Attempt to load the integration DLL from the directory containing the main client executable.
@@ -151,7 +163,7 @@ bool AchievementManager::HasAPIToken() const
   return !Config::Get(Config::RA_API_TOKEN).empty();
 }
 
-void AchievementManager::LoadGame(const DiscIO::Volume* volume)
+void AchievementManager::LoadGame(const DiscIO::Volume* volume, const std::string& file_path)
 {
   if (!Config::Get(Config::RA_ENABLED) || !HasAPIToken())
   {
@@ -166,6 +178,10 @@ void AchievementManager::LoadGame(const DiscIO::Volume* volume)
   if (volume == nullptr)
   {
     WARN_LOG_FMT(ACHIEVEMENTS, "Software format unsupported by AchievementManager.");
+    {
+      std::lock_guard lg{m_lock};
+      m_loading_file_path.clear();
+    }
     if (rc_client_get_game_info(m_client))
     {
       CloseGame();
@@ -194,7 +210,28 @@ void AchievementManager::LoadGame(const DiscIO::Volume* volume)
     {
       m_loading_volume = DiscIO::CreateVolume(volume->GetBlobReader().CopyReader());
     }
+    m_loading_file_path = file_path;
+    m_loading_with_cached_hash = false;
+  }
+  if (!file_path.empty() && !rc_client_get_game_info(m_client))
+  {
+    const std::string hash = LoadCachedHash(file_path);
+    if (!hash.empty())
+    {
+      INFO_LOG_FMT(ACHIEVEMENTS, "Using cached hash {} for {}.", hash, file_path);
+      {
+        std::lock_guard lg{m_lock};
+        m_loading_with_cached_hash = true;
+      }
+      rc_client_begin_load_game(m_client, hash.c_str(), LoadGameCallback, NULL);
+      return;
+    }
   }
+  HashAndLoadGame();
+}
+
+void AchievementManager::HashAndLoadGame()
+{
   std::lock_guard lg{m_filereader_lock};
   rc_hash_filereader volume_reader{
       .open = &AchievementManager::FilereaderOpen,
@@ -210,7 +247,7 @@ void AchievementManager::LoadGame(const DiscIO::Volume* volume)
   }
   else
   {
-    u32 console_id = FindConsoleID(volume->GetVolumeType());
+    u32 console_id = FindConsoleID(m_loading_volume->GetVolumeType());
     rc_client_begin_identify_and_load_game(m_client, console_id, "", NULL, 0, LoadGameCallback,
                                            NULL);
   }
@@ -304,55 +341,114 @@ void AchievementManager::FetchGameBadges()
         m_client, RC_CLIENT_ACHIEVEMENT_CATEGORY_CORE_AND_UNOFFICIAL,
         RC_CLIENT_ACHIEVEMENT_LIST_GROUPING_PROGRESS);
   }
+  std::vector<BadgeFetch> fetches;
   for (u32 bx = 0; bx < achievement_list->num_buckets; bx++)
   {
     auto& bucket = achievement_list->buckets[bx];
     for (u32 achievement = 0; achievement < bucket.num_achievements; achievement++)
     {
       u32 achievement_id = bucket.achievements[achievement]->id;
-
-      FetchBadge(
-          &m_unlocked_badges[achievement_id], RC_IMAGE_TYPE_ACHIEVEMENT,
-          [achievement_id](const AchievementManager& manager) {
-            if (!rc_client_get_achievement_info(manager.m_client, achievement_id))
-              return std::string("");
-            return std::string(
-                rc_client_get_achievement_info(manager.m_client, achievement_id)->badge_name);
-          },
-          {.achievements = {achievement_id}});
-      FetchBadge(
-          &m_locked_badges[achievement_id], RC_IMAGE_TYPE_ACHIEVEMENT_LOCKED,
-          [achievement_id](const AchievementManager& manager) {
-            if (!rc_client_get_achievement_info(manager.m_client, achievement_id))
-              return std::string("");
-            return std::string(
-                rc_client_get_achievement_info(manager.m_client, achievement_id)->badge_name);
-          },
-          {.achievements = {achievement_id}});
+      const auto badge_name = [achievement_id](const AchievementManager& manager) {
+        if (!rc_client_get_achievement_info(manager.m_client, achievement_id))
+          return std::string("");
+        return std::string(
+            rc_client_get_achievement_info(manager.m_client, achievement_id)->badge_name);
+      };
+
+      fetches.push_back({.badge = &m_unlocked_badges[achievement_id],
+                         .badge_type = RC_IMAGE_TYPE_ACHIEVEMENT,
+                         .function = badge_name,
+                         .callback_data = {.achievements = {achievement_id}}});
+      fetches.push_back({.badge = &m_locked_badges[achievement_id],
+                         .badge_type = RC_IMAGE_TYPE_ACHIEVEMENT_LOCKED,
+                         .function = badge_name,
+                         .callback_data = {.achievements = {achievement_id}}});
     }
   }
   rc_client_destroy_achievement_list(achievement_list);
+  FetchBadges(std::move(fetches));
 }
 
 void AchievementManager::DoFrame()
 {
   if (!(IsGameLoaded() || m_dll_found) || !Core::IsCPUThread())
     return;
+  auto& system = Core::System::GetInstance();
+  CaptureMemorySnapshot(system);
+  // Reads that miss the snapshot can't be served from another thread when the data cache is
+  // emulated, and RAIntegration expects to run on the CPU thread.
+  if (Config::Get(Config::RA_ASYNC_EVALUATION_ENABLED) && !m_dll_found &&
+      !system.GetPPCState().m_enable_dcache)
   {
-    std::lock_guard lg{m_lock};
-    rc_client_do_frame(m_client);
+    m_evaluation_queue.Push([this] { EvaluateFrame(); });
+  }
+  else
+  {
+    EvaluateFrame();
   }
   auto current_time = std::chrono::steady_clock::now();
   if (current_time - m_last_rp_time > std::chrono::seconds{10})
   {
     m_last_rp_time = current_time;
-    rc_client_get_rich_presence_message(m_client, m_rich_presence.data(), RP_SIZE);
+    const MemorySnapshotStats stats = GetMemorySnapshotStats();
+    DEBUG_LOG_FMT(ACHIEVEMENTS, "Memory snapshot: {} ranges, {} bytes, {} hits, {} misses",
+                  stats.num_ranges, stats.size, stats.hits, stats.misses);
+    {
+      std::lock_guard lg{m_lock};
+      rc_client_get_rich_presence_message(m_client, m_rich_presence.data(), RP_SIZE);
+    }
     update_event.Trigger(UpdatedItems{.rich_presence = true});
     if (Config::Get(Config::RA_DISCORD_PRESENCE_ENABLED))
       Discord::UpdateDiscordPresence();
   }
 }
 
+void AchievementManager::CaptureMemorySnapshot(Core::System& system)
+{
+  Core::CPUThreadGuard thread_guard(system);
+  const auto reader = [&system, &thread_guard](u32 address, u8* buffer, u32 num_bytes) {
+    return ReadMemory(system, thread_guard, address, buffer, num_bytes);
+  };
+
+  // The snapshot layout only changes while no evaluation is in flight, so the back buffer can be
+  // filled while the previous frame is still being evaluated.
+  {
+    std::lock_guard snapshot_lg{m_memory_snapshot_lock};
+    m_memory_snapshot.Capture(reader);
+  }
+  m_evaluation_queue.WaitForCompletion();
+
+  std::lock_guard lg{m_lock};
+  std::lock_guard snapshot_lg{m_memory_snapshot_lock};
+  if (m_memory_snapshot.HasPendingRanges())
+  {
+    m_memory_snapshot.RebuildRanges();
+    m_memory_snapshot.Capture(reader);
+  }
+  m_memory_snapshot.Swap();
+}
+
+void AchievementManager::EvaluateFrame()
+{
+  std::lock_guard lg{m_lock};
+  if (!(IsGameLoaded() || m_dll_found))
+    return;
+  s_evaluating_frame = true;
+  if (m_evaluation_profiling_enabled)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    rc_client_do_frame(m_client);
+    m_evaluation_profiler.AddFrame(std::chrono::steady_clock::now() - start);
+    m_evaluation_profiler.Evaluate(m_client);
+  }
+  else
+  {
+    rc_client_do_frame(m_client);
+  }
+  s_evaluating_frame = false;
+  ++m_progress_generation;
+}
+
 bool AchievementManager::CanPause()
 {
   if (!IsGameLoaded())
@@ -398,6 +494,7 @@ void AchievementManager::DoIdle()
         if (!m_client || !IsGameLoaded())
           return;
         rc_client_idle(m_client);
+        ++m_progress_generation;
       });
     }
   }).detach();
@@ -410,6 +507,10 @@ std::recursive_mutex& AchievementManager::GetLock()
 
 void AchievementManager::SetHardcoreMode()
 {
+  {
+    std::lock_guard lg{m_lock};
+    ++m_progress_generation;
+  }
   rc_client_set_hardcore_enabled(m_client, Config::Get(Config::RA_HARDCORE_ENABLED));
   if (Config::Get(Config::RA_HARDCORE_ENABLED))
   {
@@ -692,6 +793,82 @@ std::vector<std::string> AchievementManager::GetActiveLeaderboards() const
   return display_values;
 }
 
+AchievementManager::MemorySnapshotStats AchievementManager::GetMemorySnapshotStats() const
+{
+  std::lock_guard lg{m_lock};
+  return m_memory_snapshot.GetStats();
+}
+
+void AchievementManager::SetEvaluationProfilingEnabled(bool enabled)
+{
+  std::lock_guard lg{m_lock};
+  if (enabled == m_evaluation_profiling_enabled)
+    return;
+  m_evaluation_profiling_enabled = enabled;
+  if (enabled && IsGameLoaded())
+    m_evaluation_profiler.Load(m_game_data_response);
+  else
+    m_evaluation_profiler.Clear();
+}
+
+bool AchievementManager::IsEvaluationProfilingEnabled() const
+{
+  std::lock_guard lg{m_lock};
+  return m_evaluation_profiling_enabled;
+}
+
+void AchievementManager::ResetEvaluationProfile()
+{
+  std::lock_guard lg{m_lock};
+  m_evaluation_profiler.Reset();
+}
+
+AchievementManager::EvaluationProfile AchievementManager::GetEvaluationProfile() const
+{
+  std::lock_guard lg{m_lock};
+  return m_evaluation_profiler.GetProfile();
+}
+
+static std::string_view GetEvaluationProfileTypeName(
+    AchievementManager::EvaluationProfileEntry::Type type)
+{
+  switch (type)
+  {
+  case AchievementManager::EvaluationProfileEntry::Type::Achievement:
+    return "achievement";
+  case AchievementManager::EvaluationProfileEntry::Type::Leaderboard:
+    return "leaderboard";
+  case AchievementManager::EvaluationProfileEntry::Type::RichPresence:
+    return "rich_presence";
+  }
+  return "unknown";
+}
+
+bool AchievementManager::DumpEvaluationProfile(const std::string& path) const
+{
+  const EvaluationProfile profile = GetEvaluationProfile();
+
+  picojson::array entries;
+  for (const EvaluationProfileEntry& entry : profile.entries)
+  {
+    picojson::object object;
+    object.emplace("type", std::string(GetEvaluationProfileTypeName(entry.type)));
+    object.emplace("id", static_cast<double>(entry.id));
+    object.emplace("title", entry.title);
+    object.emplace("evaluations", static_cast<double>(entry.evaluations));
+    object.emplace("peeks", static_cast<double>(entry.peeks));
+    object.emplace("bytes_read", static_cast<double>(entry.bytes_read));
+    object.emplace("time_ns", static_cast<double>(entry.time.count()));
+    entries.emplace_back(std::move(object));
+  }
+
+  picojson::object root;
+  root.emplace("frames", static_cast<double>(profile.frames));
+  root.emplace("frame_time_ns", static_cast<double>(profile.frame_time.count()));
+  root.emplace("entries", std::move(entries));
+  return JsonToFile(path, picojson::value(std::move(root)), true);
+}
+
 #ifdef RC_CLIENT_SUPPORTS_RAINTEGRATION
 const rc_client_raintegration_menu_t* AchievementManager::GetDevelopmentMenu()
 {
@@ -712,25 +889,32 @@ void AchievementManager::DoState(PointerWrap& p)
 {
   if (!m_client || !Config::Get(Config::RA_ENABLED))
     return;
+  m_evaluation_queue.WaitForCompletion();
+  std::lock_guard lg{m_lock};
+  // Serializing the progress is only needed when it changed since the last state was taken, e.g.
+  // not when several states are taken in a row while paused, and not at all in measure mode.
+  const bool progress_cached = m_progress_buffer_generation == m_progress_generation;
   size_t size = 0;
   if (!p.IsReadMode())
-    size = rc_client_progress_size(m_client);
+    size = progress_cached ? m_progress_buffer.size() : rc_client_progress_size(m_client);
   p.Do(size);
-  auto buffer = std::make_unique<u8[]>(size);
-  if (!p.IsReadMode())
+  m_progress_buffer.resize(size);
+  if ((p.IsWriteMode() || p.IsVerifyMode()) && !progress_cached)
   {
-    int result = rc_client_serialize_progress_sized(m_client, buffer.get(), size);
+    int result = rc_client_serialize_progress_sized(m_client, m_progress_buffer.data(), size);
     if (result != RC_OK)
     {
       ERROR_LOG_FMT(ACHIEVEMENTS, "Failed serializing achievement client with error code {}",
                     result);
       return;
     }
+    m_progress_buffer_generation = m_progress_generation;
   }
-  p.DoArray(buffer.get(), (u32)size);
+  p.DoArray(m_progress_buffer.data(), static_cast<u32>(size));
   if (p.IsReadMode())
   {
-    int result = rc_client_deserialize_progress_sized(m_client, buffer.get(), size);
+    ++m_progress_generation;
+    int result = rc_client_deserialize_progress_sized(m_client, m_progress_buffer.data(), size);
     if (result != RC_OK)
     {
       ERROR_LOG_FMT(ACHIEVEMENTS, "Failed deserializing achievement client with error code {}",
@@ -744,14 +928,18 @@ void AchievementManager::DoState(PointerWrap& p)
                     size);
       return;
     }
+    // The buffer now holds exactly the progress that was just loaded.
+    m_progress_buffer_generation = m_progress_generation;
   }
   p.DoMarker("AchievementManager");
 }
 
 void AchievementManager::CloseGame()
 {
-  m_queue.Cancel();
-  m_image_queue.Cancel();
+  ++m_badge_generation;
+  m_request_pool.Cancel(REQUEST_PRIORITY_API);
+  m_request_pool.Cancel(REQUEST_PRIORITY_IMAGE);
+  m_evaluation_queue.Cancel();
   {
     std::lock_guard lg{m_lock};
     m_active_challenges.clear();
@@ -762,6 +950,13 @@ void AchievementManager::CloseGame()
     m_unlocked_badges.clear();
     m_locked_badges.clear();
     m_leaderboard_map.clear();
+    ++m_progress_generation;
+    {
+      std::lock_guard snapshot_lg{m_memory_snapshot_lock};
+      m_memory_snapshot.Clear();
+    }
+    m_game_data_response.clear();
+    m_evaluation_profiler.Clear();
     m_rich_presence.fill('\0');
     m_system.store(nullptr, std::memory_order_release);
     if (Config::Get(Config::RA_DISCORD_PRESENCE_ENABLED))
@@ -794,7 +989,9 @@ void AchievementManager::Shutdown()
   if (m_client)
   {
     CloseGame();
-    m_queue.Shutdown();
+    m_hash_queue.Shutdown();
+    m_evaluation_queue.Shutdown();
+    m_request_pool.Shutdown();
     Config::RemoveConfigChangedCallback(m_config_changed_callback_id);
     std::lock_guard lg{m_lock};
     // DON'T log out - keep those credentials for next run.
@@ -815,6 +1012,7 @@ void* AchievementManager::FilereaderOpen(const char* path_utf8)
   }
   if (!state->volume)
     return nullptr;
+  state->read_ahead_pool.Reset("AchievementManagerReadAhead", FILEREADER_READ_AHEAD_BLOCKS);
   return state.release();
 }
 
@@ -842,17 +1040,32 @@ int64_t AchievementManager::FilereaderTell(void* file_handle)
 size_t AchievementManager::FilereaderRead(void* file_handle, void* buffer, size_t requested_bytes)
 {
   FilereaderState* filereader_state = static_cast<FilereaderState*>(file_handle);
-  bool success = (filereader_state->volume->Read(filereader_state->position, requested_bytes,
-                                                 static_cast<u8*>(buffer), DiscIO::PARTITION_NONE));
-  if (success)
-  {
-    filereader_state->position += requested_bytes;
-    return requested_bytes;
+  u8* out_ptr = static_cast<u8*>(buffer);
+  size_t num_read = 0;
+  while (num_read < requested_bytes)
+  {
+    const u64 position = static_cast<u64>(filereader_state->position) + num_read;
+    const u64 offset_in_block = position % FILEREADER_BLOCK_SIZE;
+    if (!FilereaderLoadBlock(filereader_state, position - offset_in_block) ||
+        offset_in_block >= filereader_state->block.size())
+    {
+      break;
+    }
+    const size_t num_to_copy = static_cast<size_t>(std::min<u64>(
+        filereader_state->block.size() - offset_in_block, requested_bytes - num_read));
+    std::memcpy(out_ptr + num_read, filereader_state->block.data() + offset_in_block, num_to_copy);
+    num_read += num_to_copy;
   }
-  else
+
+  // Reads past the reported data size can still succeed for some blob types.
+  if (num_read < requested_bytes &&
+      !filereader_state->volume->Read(filereader_state->position, requested_bytes, out_ptr,
+                                      DiscIO::PARTITION_NONE))
   {
     return 0;
   }
+  filereader_state->position += requested_bytes;
+  return requested_bytes;
 }
 
 void AchievementManager::FilereaderClose(void* file_handle)
@@ -860,6 +1073,153 @@ void AchievementManager::FilereaderClose(void* file_handle)
   delete static_cast<FilereaderState*>(file_handle);
 }
 
+bool AchievementManager::FilereaderLoadBlock(FilereaderState* state, u64 block_offset)
+{
+  if (!state->block.empty() && state->block_offset == block_offset)
+    return true;
+
+  state->block.clear();
+  // Blocks that were prefetched ahead of the requested one belong to a different read pattern, so
+  // they are thrown away.
+  while (!state->prefetched_blocks.empty())
+  {
+    auto [offset, future] = std::move(state->prefetched_blocks.front());
+    state->prefetched_blocks.pop_front();
+    FilereaderBlock fetched = future.get();
+    if (fetched.volume)
+      state->idle_volumes.push_back(std::move(fetched.volume));
+    if (offset == block_offset)
+    {
+      state->block = std::move(fetched.data);
+      break;
+    }
+  }
+
+  if (state->block.empty())
+  {
+    const u64 data_size = state->volume->GetDataSize();
+    if (block_offset >= data_size)
+      return false;
+    state->block.resize(std::min(FILEREADER_BLOCK_SIZE, data_size - block_offset));
+    if (!state->volume->Read(block_offset, state->block.size(), state->block.data(),
+                             DiscIO::PARTITION_NONE))
+    {
+      state->block.clear();
+      return false;
+    }
+  }
+  state->block_offset = block_offset;
+  FilereaderPrefetch(state);
+  return true;
+}
+
+void AchievementManager::FilereaderPrefetch(FilereaderState* state)
+{
+  const u64 data_size = state->volume->GetDataSize();
+  u64 next_offset = (state->prefetched_blocks.empty() ? state->block_offset :
+                                                        state->prefetched_blocks.back().first) +
+                    FILEREADER_BLOCK_SIZE;
+  while (state->prefetched_blocks.size() < FILEREADER_READ_AHEAD_BLOCKS && next_offset < data_size)
+  {
+    std::unique_ptr<DiscIO::Volume> volume;
+    if (!state->idle_volumes.empty())
+    {
+      volume = std::move(state->idle_volumes.back());
+      state->idle_volumes.pop_back();
+    }
+    else
+    {
+      volume = DiscIO::CreateVolume(state->volume->GetBlobReader().CopyReader());
+      if (!volume)
+        return;
+    }
+
+    const u64 size = std::min(FILEREADER_BLOCK_SIZE, data_size - next_offset);
+    auto read_block = [volume = std::move(volume), offset = next_offset, size]() mutable {
+      FilereaderBlock block{.data = std::vector<u8>(size), .volume = std::move(volume)};
+      if (!block.volume->Read(offset, size, block.data.data(), DiscIO::PARTITION_NONE))
+        block.data.clear();
+      return block;
+    };
+    // The pool only takes copyable functions, while the task owns the volume.
+    auto task = std::make_shared<std::packaged_task<FilereaderBlock()>>(std::move(read_block));
+    state->prefetched_blocks.emplace_back(next_offset, task->get_future());
+    state->read_ahead_pool.Push(0, [task] { (*task)(); });
+    next_offset += FILEREADER_BLOCK_SIZE;
+  }
+}
+
+// Identifies the exact file a cached hash was computed from, so that a replaced or modified image
+// is hashed again.
+static std::string GetHashCacheStamp(const std::string& file_path)
+{
+  std::error_code error;
+  const auto modified = std::filesystem::last_write_time(StringToPath(file_path), error);
+  if (error)
+    return "";
+  return fmt::format("{}:{}", File::GetSize(file_path), modified.time_since_epoch().count());
+}
+
+std::string AchievementManager::LoadCachedHash(const std::string& file_path)
+{
+  const std::string stamp = GetHashCacheStamp(file_path);
+  if (stamp.empty())
+    return "";
+
+  const std::string cache_path =
+      File::GetUserPath(D_RETROACHIEVEMENTSCACHE_IDX) + std::string(HASH_CACHE_FILENAME);
+  picojson::value root;
+  std::string error;
+  if (!JsonFromFile(cache_path, &root, &error) || !root.is<picojson::object>())
+    return "";
+
+  const auto& cache = root.get<picojson::object>();
+  const auto entry = cache.find(file_path);
+  if (entry == cache.end() || !entry->second.is<picojson::object>())
+    return "";
+  const auto& entry_object = entry->second.get<picojson::object>();
+  if (ReadStringFromJson(entry_object, "stamp") != stamp)
+    return "";
+  const auto hash = ReadStringFromJson(entry_object, "hash");
+  if (!hash || hash->size() != HASH_SIZE - 1)
+    return "";
+  return *hash;
+}
+
+void AchievementManager::StoreCachedHash(const std::string& file_path, std::string_view hash)
+{
+  const std::string stamp = GetHashCacheStamp(file_path);
+  if (stamp.empty() || hash.size() != HASH_SIZE - 1)
+    return;
+
+  const std::string cache_path =
+      File::GetUserPath(D_RETROACHIEVEMENTSCACHE_IDX) + std::string(HASH_CACHE_FILENAME);
+  picojson::value root;
+  std::string error;
+  if (!JsonFromFile(cache_path, &root, &error) || !root.is<picojson::object>())
+    root = picojson::value(picojson::object{});
+
+  auto& cache = root.get<picojson::object>();
+  if (const auto it = cache.find(file_path);
+      it != cache.end() && it->second.is<picojson::object>())
+  {
+    // Don't rewrite the whole cache for every game that's loaded from it.
+    const auto& entry_object = it->second.get<picojson::object>();
+    if (ReadStringFromJson(entry_object, "stamp") == stamp &&
+        ReadStringFromJson(entry_object, "hash") == hash)
+    {
+      return;
+    }
+  }
+
+  picojson::object entry;
+  entry.emplace("stamp", stamp);
+  entry.emplace("hash", std::string(hash));
+  cache[file_path] = picojson::value(std::move(entry));
+  if (!JsonToFile(cache_path, root))
+    WARN_LOG_FMT(ACHIEVEMENTS, "Failed to store hash for {} to cache", file_path);
+}
+
 u32 AchievementManager::FindConsoleID(const DiscIO::Platform& platform)
 {
   switch (platform)
@@ -1006,7 +1366,28 @@ void AchievementManager::LoadGameCallback(int result, const char* error_message,
                                           rc_client_t* client, void* userdata)
 {
   auto& instance = AchievementManager::GetInstance();
+  bool loaded_with_cached_hash;
+  {
+    std::lock_guard lg{instance.GetLock()};
+    loaded_with_cached_hash = std::exchange(instance.m_loading_with_cached_hash, false);
+  }
+  // The cached hash can go stale in ways that its stamp doesn't catch, so a rejected one is no
+  // reason to give up on the game before hashing it.
+  if (loaded_with_cached_hash && instance.m_loading_volume && result != RC_OK &&
+      result != RC_API_FAILURE && result != RC_LOGIN_REQUIRED &&
+      result != RC_INVALID_CREDENTIALS && result != RC_EXPIRED_TOKEN)
+  {
+    WARN_LOG_FMT(ACHIEVEMENTS, "Cached hash was rejected, hashing the game instead.");
+    instance.m_hash_queue.Push([&instance] { instance.HashAndLoadGame(); });
+    return;
+  }
+
   instance.m_loading_volume.reset(nullptr);
+  std::string file_path;
+  {
+    std::lock_guard lg{instance.GetLock()};
+    file_path = std::exchange(instance.m_loading_file_path, {});
+  }
   if (result == RC_API_FAILURE)
   {
     WARN_LOG_FMT(ACHIEVEMENTS, "Load data request rejected for old Dolphin version.");
@@ -1042,6 +1423,8 @@ void AchievementManager::LoadGameCallback(int result, const char* error_message,
     {
       INFO_LOG_FMT(ACHIEVEMENTS, "Loaded data for game ID {}.", game->id);
       instance.m_display_welcome_message = true;
+      if (!file_path.empty() && game->hash)
+        StoreCachedHash(file_path, game->hash);
     }
   }
   else
@@ -1054,6 +1437,12 @@ void AchievementManager::LoadGameCallback(int result, const char* error_message,
   if (game == nullptr)
     return;
 
+  {
+    std::lock_guard lg{instance.GetLock()};
+    ++instance.m_progress_generation;
+    if (instance.m_evaluation_profiling_enabled)
+      instance.m_evaluation_profiler.Load(instance.m_game_data_response);
+  }
   instance.FetchGameBadges();
   instance.m_system.store(&Core::System::GetInstance(), std::memory_order_release);
   instance.update_event.Trigger({.all = true});
@@ -1280,7 +1669,8 @@ void AchievementManager::HandleGameCompletedEvent(const rc_client_event_t* clien
 void AchievementManager::HandleResetEvent(const rc_client_event_t* client_event)
 {
   INFO_LOG_FMT(ACHIEVEMENTS, "Reset requested by Achievement Manager");
-  Core::Stop(Core::System::GetInstance());
+  // Events may be raised on the evaluation thread, which CloseGame waits on.
+  Core::QueueHostJob([](Core::System& system) { Core::Stop(system); });
 }
 
 void AchievementManager::HandleServerErrorEvent(const rc_client_event_t* client_event)
@@ -1289,44 +1679,229 @@ void AchievementManager::HandleServerErrorEvent(const rc_client_event_t* client_
                 client_event->server_error->api, client_event->server_error->error_message);
 }
 
+// Game data only changes when the set is edited, so it's revalidated against the cached copy
+// instead of being downloaded again every session.
+static bool IsCacheableRequest(std::string_view post_data)
+{
+  return post_data.starts_with("r=patch&");
+}
+
+static bool WriteCacheFile(const std::string& cache_path, std::span<const u8> data)
+{
+  const std::string temp_path = fmt::format("{}.tmp", cache_path);
+  File::IOFile temp_file(temp_path, "wb");
+  if (!temp_file.IsOpen() || !temp_file.WriteBytes(data.data(), data.size()) ||
+      !temp_file.Close() || !File::Rename(temp_path, cache_path))
+  {
+    File::Delete(temp_path);
+    return false;
+  }
+  return true;
+}
+
+// Adds the conditional request headers for a cached response, so that the server can answer with
+// 304 Not Modified instead of sending it again.
+static void AddCacheValidators(Common::HttpRequest::Headers* headers, const std::string& cache_path)
+{
+  picojson::value root;
+  std::string error;
+  if (!JsonFromFile(cache_path + std::string(AchievementManager::CACHE_VALIDATORS_SUFFIX), &root,
+                    &error) ||
+      !root.is<picojson::object>())
+  {
+    return;
+  }
+
+  const auto& validators = root.get<picojson::object>();
+  if (const auto etag = ReadStringFromJson(validators, "etag"); etag && !etag->empty())
+    headers->emplace("If-None-Match", *etag);
+  if (const auto last_modified = ReadStringFromJson(validators, "last_modified");
+      last_modified && !last_modified->empty())
+  {
+    headers->emplace("If-Modified-Since", *last_modified);
+  }
+}
+
+// Returns false if the response carries no validators, in which case it can't be revalidated.
+static bool StoreCacheValidators(const Common::HttpRequest& http_request,
+                                 const std::string& cache_path)
+{
+  const std::string validators_path =
+      cache_path + std::string(AchievementManager::CACHE_VALIDATORS_SUFFIX);
+  const std::string etag = http_request.GetHeaderValue("ETag");
+  const std::string last_modified = http_request.GetHeaderValue("Last-Modified");
+  if (etag.empty() && last_modified.empty())
+  {
+    File::Delete(validators_path);
+    return false;
+  }
+
+  picojson::object validators;
+  validators.emplace("etag", etag);
+  validators.emplace("last_modified", last_modified);
+  return JsonToFile(validators_path, picojson::value(std::move(validators)));
+}
+
+static bool IsSubmissionRequest(std::string_view post_data)
+{
+  return post_data.starts_with("r=awardachievement&") || post_data.starts_with("r=submitlbentry&");
+}
+
+// Each request thread keeps its own HttpRequest, so that its connection to the server is reused
+// instead of being set up again for every request.
+static Common::HttpRequest& GetThreadHttpRequest()
+{
+  static thread_local Common::HttpRequest http_request;
+  return http_request;
+}
+
 void AchievementManager::Request(const rc_api_request_t* request,
                                  rc_client_server_callback_t callback, void* callback_data,
                                  rc_client_t* client)
 {
   std::string url = request->url;
   std::string post_data = request->post_data;
-  AchievementManager::GetInstance().m_queue.Push(
-      [url = std::move(url), post_data = std::move(post_data), callback, callback_data] {
-        Common::HttpRequest http_request;
-        Common::HttpRequest::Response http_response;
-        if (!post_data.empty())
-        {
-          http_response = http_request.Post(url, post_data, USER_AGENT_HEADER,
-                                            Common::HttpRequest::AllowedReturnCodes::All);
-        }
-        else
-        {
-          http_response = http_request.Get(url, USER_AGENT_HEADER,
-                                           Common::HttpRequest::AllowedReturnCodes::All);
-        }
+  auto& instance = AchievementManager::GetInstance();
+  const RequestPriority priority =
+      IsSubmissionRequest(post_data) ? REQUEST_PRIORITY_SUBMISSION : REQUEST_PRIORITY_API;
+  instance.m_request_pool.Push(priority, [url = std::move(url), post_data = std::move(post_data),
+                                          callback, callback_data] {
+    PerformRequest(url, post_data, callback, callback_data);
+  });
+}
 
-        rc_api_server_response_t server_response;
-        if (http_response.has_value() && http_response->size() > 0)
-        {
-          server_response.body = reinterpret_cast<const char*>(http_response->data());
-          server_response.body_length = http_response->size();
-          server_response.http_status_code = http_request.GetLastResponseCode();
-        }
-        else
-        {
-          static constexpr char error_message[] = "Failed HTTP request.";
-          server_response.body = error_message;
-          server_response.body_length = sizeof(error_message);
-          server_response.http_status_code = RC_API_SERVER_RESPONSE_RETRYABLE_CLIENT_ERROR;
-        }
+void AchievementManager::PerformRequest(const std::string& url, const std::string& post_data,
+                                        rc_client_server_callback_t callback, void* callback_data)
+{
+  Common::HttpRequest& http_request = GetThreadHttpRequest();
+  Common::HttpRequest::Response http_response;
+  Common::HttpRequest::Headers headers = USER_AGENT_HEADER;
+  std::string cache_path;
+  if (IsCacheableRequest(post_data))
+  {
+    cache_path =
+        fmt::format("{}/response-{}.json", File::GetUserPath(D_RETROACHIEVEMENTSCACHE_IDX),
+                    Common::SHA1::DigestToString(Common::SHA1::CalculateDigest(url + post_data)));
+    AddCacheValidators(&headers, cache_path);
+  }
+  if (!post_data.empty())
+  {
+    http_response =
+        http_request.Post(url, post_data, headers, Common::HttpRequest::AllowedReturnCodes::All);
+  }
+  else
+  {
+    http_response = http_request.Get(url, headers, Common::HttpRequest::AllowedReturnCodes::All);
+  }
 
-        callback(&server_response, callback_data);
-      });
+  s32 response_code = http_request.GetLastResponseCode();
+  if (!cache_path.empty())
+  {
+    std::string cached_response;
+    if (response_code == 304 && File::ReadFileToString(cache_path, cached_response))
+    {
+      INFO_LOG_FMT(ACHIEVEMENTS, "Using cached response for {}", url);
+      http_response = std::vector<u8>(cached_response.begin(), cached_response.end());
+      response_code = 200;
+    }
+    else if (response_code == 200 && http_response.has_value() && !http_response->empty())
+    {
+      if (!WriteCacheFile(cache_path, *http_response) ||
+          !StoreCacheValidators(http_request, cache_path))
+      {
+        File::Delete(cache_path);
+      }
+    }
+    if (response_code == 200 && http_response.has_value())
+    {
+      auto& instance = GetInstance();
+      std::lock_guard lg{instance.GetLock()};
+      instance.m_game_data_response.assign(http_response->begin(), http_response->end());
+    }
+  }
+
+  rc_api_server_response_t server_response;
+  if (http_response.has_value() && http_response->size() > 0)
+  {
+    server_response.body = reinterpret_cast<const char*>(http_response->data());
+    server_response.body_length = http_response->size();
+    server_response.http_status_code = response_code;
+  }
+  else
+  {
+    static constexpr char error_message[] = "Failed HTTP request.";
+    server_response.body = error_message;
+    server_response.body_length = sizeof(error_message);
+    server_response.http_status_code = RC_API_SERVER_RESPONSE_RETRYABLE_CLIENT_ERROR;
+  }
+
+  callback(&server_response, callback_data);
+}
+
+// Returns the host memory backing the given physical address up to the end of its MEM1/MEM2
+// region, or an empty span if the address isn't plain RAM.
+static std::span<const u8> GetPhysicalRAMSpan(Memory::MemoryManager& memory, u32 address)
+{
+  if (memory.GetRAM() && address < memory.GetRamSizeReal())
+    return std::span(memory.GetRAM() + address, memory.GetRamSizeReal() - address);
+
+  if (memory.GetEXRAM() && (address >> 28) == 0x1 &&
+      (address & 0x0FFFFFFF) < memory.GetExRamSizeReal())
+  {
+    const u32 offset = address & 0x0FFFFFFF;
+    return std::span(memory.GetEXRAM() + offset, memory.GetExRamSizeReal() - offset);
+  }
+
+  return {};
+}
+
+u32 AchievementManager::ReadMemory(Core::System& system, const Core::CPUThreadGuard& guard,
+                                   u32 address, u8* buffer, u32 num_bytes)
+{
+  auto& memory = system.GetMemory();
+  // With the data cache emulated, RAM contents can be stale, so every read has to go through the
+  // MMU. Otherwise contiguous bytes can be copied straight out of MEM1/MEM2.
+  const bool direct_access = !system.GetPPCState().m_enable_dcache;
+  u32 num_read = 0;
+  while (num_read < num_bytes)
+  {
+    const u32 current_address = address + num_read;
+    if (direct_access)
+    {
+      const auto span = GetPhysicalRAMSpan(memory, current_address);
+      if (!span.empty())
+      {
+        const u32 num_to_copy =
+            static_cast<u32>(std::min<size_t>(span.size(), num_bytes - num_read));
+        std::memcpy(buffer + num_read, span.data(), num_to_copy);
+        num_read += num_to_copy;
+        continue;
+      }
+    }
+    auto value = system.GetMMU().HostTryRead<u8>(guard, current_address,
+                                                 PowerPC::RequestedAddressSpace::Physical);
+    if (!value.has_value())
+      return num_read;
+    buffer[num_read++] = value.value().value;
+  }
+  return num_bytes;
+}
+
+u32 AchievementManager::ReadRAMUnsynchronized(Core::System& system, u32 address, u8* buffer,
+                                              u32 num_bytes)
+{
+  auto& memory = system.GetMemory();
+  u32 num_read = 0;
+  while (num_read < num_bytes)
+  {
+    const auto span = GetPhysicalRAMSpan(memory, address + num_read);
+    if (span.empty())
+      break;
+    const u32 num_to_copy = static_cast<u32>(std::min<size_t>(span.size(), num_bytes - num_read));
+    std::memcpy(buffer + num_read, span.data(), num_to_copy);
+    num_read += num_to_copy;
+  }
+  return num_read;
 }
 
 u32 AchievementManager::MemoryPeeker(u32 address, u8* buffer, u32 num_bytes, rc_client_t* client)
@@ -1334,110 +1909,430 @@ u32 AchievementManager::MemoryPeeker(u32 address, u8* buffer, u32 num_bytes, rc_
   if (buffer == nullptr)
     return 0u;
   auto& system = Core::System::GetInstance();
+  if (s_evaluating_frame)
+  {
+    auto& instance = GetInstance();
+    if (instance.m_memory_snapshot.Read(address, buffer, num_bytes))
+      return num_bytes;
+    instance.m_memory_snapshot.RecordMiss(address, num_bytes);
+    // Taking a CPUThreadGuard on the evaluation thread would deadlock with DoFrame waiting for
+    // this frame to finish, so read RAM directly, like the GPU thread does in dual core mode.
+    if (!Core::IsCPUThread())
+      return ReadRAMUnsynchronized(system, address, buffer, num_bytes);
+  }
   Core::CPUThreadGuard thread_guard(system);
-  for (u32 num_read = 0; num_read < num_bytes; num_read++)
+  return ReadMemory(system, thread_guard, address, buffer, num_bytes);
+}
+
+bool AchievementManager::MemorySnapshot::Read(u32 address, u8* buffer, u32 num_bytes)
+{
+  auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), address,
+                             [](u32 addr, const Range& range) { return addr < range.address; });
+  if (it != m_ranges.begin())
   {
-    auto value = system.GetMMU().HostTryRead<u8>(thread_guard, address + num_read,
-                                                 PowerPC::RequestedAddressSpace::Physical);
-    if (!value.has_value())
-      return num_read;
-    buffer[num_read] = value.value().value;
+    --it;
+    const u64 end = u64{address - it->address} + num_bytes;
+    if (end <= it->valid_size[m_front])
+    {
+      std::memcpy(buffer, m_buffers[m_front].data() + it->offset + (address - it->address),
+                  num_bytes);
+      it->used = true;
+      ++m_hits;
+      return true;
+    }
   }
-  return num_bytes;
+  ++m_misses;
+  return false;
+}
+
+void AchievementManager::MemorySnapshot::RecordMiss(u32 address, u32 num_bytes)
+{
+  if (num_bytes != 0)
+    m_pending_ranges.emplace_back(address, num_bytes);
+}
+
+void AchievementManager::MemorySnapshot::Capture(const Reader& reader)
+{
+  const size_t back = m_front ^ 1;
+  for (Range& range : m_ranges)
+  {
+    range.valid_size[back] =
+        reader(range.address, m_buffers[back].data() + range.offset, range.size);
+  }
+}
+
+void AchievementManager::MemorySnapshot::Swap()
+{
+  m_front ^= 1;
+  for (Range& range : m_ranges)
+    range.used = false;
+}
+
+void AchievementManager::MemorySnapshot::RebuildRanges()
+{
+  // Reads that are this close together are captured as a single range, since copying a few
+  // unreferenced bytes is cheaper than an extra lookup.
+  static constexpr u64 MERGE_DISTANCE = 32;
+
+  std::vector<std::pair<u64, u64>> spans;
+  spans.reserve(m_ranges.size() + m_pending_ranges.size());
+  for (const Range& range : m_ranges)
+  {
+    if (range.used)
+      spans.emplace_back(range.address, u64{range.address} + range.size);
+  }
+  for (const auto& [address, size] : m_pending_ranges)
+    spans.emplace_back(address, u64{address} + size);
+  m_pending_ranges.clear();
+  std::sort(spans.begin(), spans.end());
+
+  m_ranges.clear();
+  size_t offset = 0;
+  for (const auto& [start, end] : spans)
+  {
+    if (!m_ranges.empty())
+    {
+      Range& last = m_ranges.back();
+      const u64 last_end = u64{last.address} + last.size;
+      if (start <= last_end + MERGE_DISTANCE)
+      {
+        if (end > last_end)
+        {
+          offset += end - last_end;
+          last.size = static_cast<u32>(end - last.address);
+        }
+        continue;
+      }
+    }
+    m_ranges.push_back(Range{.address = static_cast<u32>(start),
+                             .size = static_cast<u32>(end - start),
+                             .valid_size = {},
+                             .offset = offset,
+                             .used = false});
+    offset += end - start;
+  }
+  for (auto& buffer : m_buffers)
+    buffer.resize(offset);
+
+  DEBUG_LOG_FMT(ACHIEVEMENTS, "Rebuilt achievement memory snapshot: {} ranges, {} bytes",
+                m_ranges.size(), offset);
+}
+
+void AchievementManager::MemorySnapshot::Clear()
+{
+  m_ranges.clear();
+  m_pending_ranges.clear();
+  for (auto& buffer : m_buffers)
+    buffer.clear();
+  m_hits = 0;
+  m_misses = 0;
+}
+
+AchievementManager::MemorySnapshotStats AchievementManager::MemorySnapshot::GetStats() const
+{
+  return {.hits = m_hits,
+          .misses = m_misses,
+          .num_ranges = static_cast<u32>(m_ranges.size()),
+          .size = static_cast<u32>(m_buffers[m_front].size())};
+}
+
+void AchievementManager::EvaluationProfiler::Load(std::string_view game_data)
+{
+  Clear();
+
+  rc_api_server_response_t server_response{};
+  server_response.body = game_data.data();
+  server_response.body_length = game_data.size();
+  server_response.http_status_code = 200;
+  rc_api_fetch_game_data_response_t response{};
+  const int result = rc_api_process_fetch_game_data_server_response(&response, &server_response);
+  Common::ScopeGuard on_end_scope([&] { rc_api_destroy_fetch_game_data_response(&response); });
+  if (result != RC_OK || !response.response.succeeded)
+  {
+    WARN_LOG_FMT(ACHIEVEMENTS, "Evaluation profiler failed to read game data with error code {}",
+                 result);
+    return;
+  }
+
+  const auto add_definition = [this](EvaluationProfileEntry::Type type, AchievementId id,
+                                     const char* title, const char* script) {
+    if (script == nullptr || *script == '\0')
+      return;
+    Definition definition{.entry = {.type = type, .id = id, .title = title ? title : ""}};
+    int size;
+    switch (type)
+    {
+    case EvaluationProfileEntry::Type::Achievement:
+      size = rc_trigger_size(script);
+      break;
+    case EvaluationProfileEntry::Type::Leaderboard:
+      size = rc_lboard_size(script);
+      break;
+    default:
+      size = rc_richpresence_size(script);
+      break;
+    }
+    if (size < 0)
+    {
+      WARN_LOG_FMT(ACHIEVEMENTS, "Evaluation profiler failed to parse {} {} with error code {}",
+                   GetEvaluationProfileTypeName(type), id, size);
+      return;
+    }
+    definition.buffer.resize(size);
+    switch (type)
+    {
+    case EvaluationProfileEntry::Type::Achievement:
+      definition.trigger = rc_parse_trigger(definition.buffer.data(), script, nullptr, 0);
+      break;
+    case EvaluationProfileEntry::Type::Leaderboard:
+      definition.lboard = rc_parse_lboard(definition.buffer.data(), script, nullptr, 0);
+      break;
+    default:
+      definition.richpresence = rc_parse_richpresence(definition.buffer.data(), script, nullptr, 0);
+      break;
+    }
+    if (definition.trigger || definition.lboard || definition.richpresence)
+      m_definitions.push_back(std::move(definition));
+  };
+
+  for (u32 i = 0; i < response.num_achievements; ++i)
+  {
+    const auto& achievement = response.achievements[i];
+    add_definition(EvaluationProfileEntry::Type::Achievement, achievement.id, achievement.title,
+                   achievement.definition);
+  }
+  for (u32 i = 0; i < response.num_leaderboards; ++i)
+  {
+    const auto& leaderboard = response.leaderboards[i];
+    add_definition(EvaluationProfileEntry::Type::Leaderboard, leaderboard.id, leaderboard.title,
+                   leaderboard.definition);
+  }
+  add_definition(EvaluationProfileEntry::Type::RichPresence, 0, "Rich Presence",
+                 response.rich_presence_script);
+
+  INFO_LOG_FMT(ACHIEVEMENTS, "Evaluation profiler loaded {} definitions.", m_definitions.size());
+}
+
+void AchievementManager::EvaluationProfiler::Evaluate(rc_client_t* client)
+{
+  for (Definition& definition : m_definitions)
+  {
+    EvaluationProfileEntry& entry = definition.entry;
+    // Only profile what rc_client is currently evaluating itself.
+    if (definition.trigger)
+    {
+      const auto* achievement = rc_client_get_achievement_info(client, entry.id);
+      if (!achievement || achievement->state != RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE)
+        continue;
+    }
+    else if (definition.lboard)
+    {
+      const auto* leaderboard = rc_client_get_leaderboard_info(client, entry.id);
+      if (!leaderboard || leaderboard->state == RC_CLIENT_LEADERBOARD_STATE_INACTIVE ||
+          leaderboard->state == RC_CLIENT_LEADERBOARD_STATE_DISABLED)
+      {
+        continue;
+      }
+    }
+
+    m_current_entry = &entry;
+    const auto start = std::chrono::steady_clock::now();
+    if (definition.trigger)
+    {
+      rc_evaluate_trigger(definition.trigger, Peek, this, nullptr);
+    }
+    else if (definition.lboard)
+    {
+      int32_t value;
+      rc_evaluate_lboard(definition.lboard, &value, Peek, this, nullptr);
+    }
+    else
+    {
+      rc_update_richpresence(definition.richpresence, Peek, this, nullptr);
+    }
+    entry.time += std::chrono::steady_clock::now() - start;
+    ++entry.evaluations;
+  }
+  m_current_entry = nullptr;
+}
+
+void AchievementManager::EvaluationProfiler::AddFrame(std::chrono::nanoseconds frame_time)
+{
+  ++m_frames;
+  m_frame_time += frame_time;
+}
+
+void AchievementManager::EvaluationProfiler::Reset()
+{
+  for (Definition& definition : m_definitions)
+  {
+    definition.entry.evaluations = 0;
+    definition.entry.peeks = 0;
+    definition.entry.bytes_read = 0;
+    definition.entry.time = {};
+  }
+  m_frames = 0;
+  m_frame_time = {};
+}
+
+void AchievementManager::EvaluationProfiler::Clear()
+{
+  m_definitions.clear();
+  m_frames = 0;
+  m_frame_time = {};
+}
+
+AchievementManager::EvaluationProfile AchievementManager::EvaluationProfiler::GetProfile() const
+{
+  EvaluationProfile profile{.frames = m_frames, .frame_time = m_frame_time};
+  profile.entries.reserve(m_definitions.size());
+  for (const Definition& definition : m_definitions)
+    profile.entries.push_back(definition.entry);
+  return profile;
+}
+
+u32 AchievementManager::EvaluationProfiler::Peek(u32 address, u32 num_bytes, void* userdata)
+{
+  auto* profiler = static_cast<EvaluationProfiler*>(userdata);
+  std::array<u8, 4> buffer{};
+  num_bytes = std::min<u32>(num_bytes, static_cast<u32>(buffer.size()));
+  ++profiler->m_current_entry->peeks;
+  profiler->m_current_entry->bytes_read += num_bytes;
+  if (MemoryPeeker(address, buffer.data(), num_bytes, nullptr) != num_bytes)
+    return 0;
+  // rcheevos expects the bytes combined in little endian order, like rc_client does for its peeks.
+  u32 value = 0;
+  for (u32 i = 0; i < num_bytes; ++i)
+    value |= u32{buffer[i]} << (8 * i);
+  return value;
 }
 
 void AchievementManager::FetchBadge(AchievementManager::Badge* badge, u32 badge_type,
                                     const AchievementManager::BadgeNameFunction function,
                                     UpdatedItems callback_data)
+{
+  FetchBadges({{.badge = badge,
+                .badge_type = badge_type,
+                .function = std::move(function),
+                .callback_data = std::move(callback_data)}});
+}
+
+void AchievementManager::FetchBadges(std::vector<BadgeFetch> fetches)
 {
   if (!m_client || !HasAPIToken())
   {
-    update_event.Trigger(callback_data);
-    if (m_display_welcome_message && badge_type == RC_IMAGE_TYPE_GAME)
-      DisplayWelcomeMessage();
+    for (const BadgeFetch& fetch : fetches)
+    {
+      update_event.Trigger(fetch.callback_data);
+      if (m_display_welcome_message && fetch.badge_type == RC_IMAGE_TYPE_GAME)
+        DisplayWelcomeMessage();
+    }
     return;
   }
 
-  m_image_queue.Push([this, badge, badge_type, function = std::move(function),
-                      callback_data = std::move(callback_data)] {
-    Common::ScopeGuard on_end_scope([&] {
-      if (m_display_welcome_message && badge_type == RC_IMAGE_TYPE_GAME)
-        DisplayWelcomeMessage();
-    });
-
-    std::string name_to_fetch;
+  // All badges of a set go through a single job, rather than queueing one job per badge.
+  m_request_pool.Push(REQUEST_PRIORITY_IMAGE, [this, fetches = std::move(fetches),
+                                               generation = m_badge_generation.load()] {
+    for (const BadgeFetch& fetch : fetches)
     {
-      std::lock_guard lg{m_lock};
-      name_to_fetch = function(*this);
-      if (name_to_fetch.empty())
+      if (m_badge_generation.load() != generation)
         return;
+      LoadBadge(fetch);
     }
+  });
+}
+
+void AchievementManager::LoadBadge(const BadgeFetch& fetch)
+{
+  Common::ScopeGuard on_end_scope([&] {
+    if (m_display_welcome_message && fetch.badge_type == RC_IMAGE_TYPE_GAME)
+      DisplayWelcomeMessage();
+  });
+
+  std::string name_to_fetch;
+  {
+    std::lock_guard lg{m_lock};
+    name_to_fetch = fetch.function(*this);
+    if (name_to_fetch.empty())
+      return;
+  }
 
-    const std::string cache_path = fmt::format(
-        "{}/badge-{}-{}.png", File::GetUserPath(D_RETROACHIEVEMENTSCACHE_IDX), badge_type,
-        Common::SHA1::DigestToString(Common::SHA1::CalculateDigest(name_to_fetch)));
+  const std::string cache_path = fmt::format(
+      "{}/badge-{}-{}.png", File::GetUserPath(D_RETROACHIEVEMENTSCACHE_IDX), fetch.badge_type,
+      Common::SHA1::DigestToString(Common::SHA1::CalculateDigest(name_to_fetch)));
 
-    AchievementManager::Badge tmp_badge;
-    if (!LoadPNGTexture(&tmp_badge, cache_path))
+  AchievementManager::Badge tmp_badge;
+  const bool cached = LoadPNGTexture(&tmp_badge, cache_path);
+  // Game and achievement badge names change whenever their image does, so cached copies can be used
+  // as they are. User pictures are named after the user and have to be revalidated.
+  if (!cached || fetch.badge_type == RC_IMAGE_TYPE_USER)
+  {
+    rc_api_fetch_image_request_t icon_request = {.image_name = name_to_fetch.c_str(),
+                                                 .image_type = fetch.badge_type};
+    rc_api_request_t api_request;
+    Common::HttpRequest& http_request = GetThreadHttpRequest();
+    if (rc_api_init_fetch_image_request(&api_request, &icon_request) != RC_OK)
     {
-      rc_api_fetch_image_request_t icon_request = {.image_name = name_to_fetch.c_str(),
-                                                   .image_type = badge_type};
-      Badge fetched_badge;
-      rc_api_request_t api_request;
-      Common::HttpRequest http_request;
-      if (rc_api_init_fetch_image_request(&api_request, &icon_request) != RC_OK)
-      {
-        ERROR_LOG_FMT(ACHIEVEMENTS, "Invalid request for image {}.", name_to_fetch);
-        return;
-      }
-      auto http_response = http_request.Get(api_request.url, USER_AGENT_HEADER,
-                                            Common::HttpRequest::AllowedReturnCodes::All);
-      if (!http_response.has_value() || http_response->empty())
+      ERROR_LOG_FMT(ACHIEVEMENTS, "Invalid request for image {}.", name_to_fetch);
+      return;
+    }
+    Common::HttpRequest::Headers headers = USER_AGENT_HEADER;
+    if (cached)
+      AddCacheValidators(&headers, cache_path);
+    auto http_response =
+        http_request.Get(api_request.url, headers, Common::HttpRequest::AllowedReturnCodes::All);
+    if (cached && http_request.GetLastResponseCode() == 304)
+    {
+      INFO_LOG_FMT(ACHIEVEMENTS, "Cached badge id {} is up to date.", name_to_fetch);
+    }
+    else if (!http_response.has_value() || http_response->empty())
+    {
+      WARN_LOG_FMT(ACHIEVEMENTS, "RetroAchievements connection failed on image request.\n URL: {}",
+                   api_request.url);
+      if (!cached)
       {
-        WARN_LOG_FMT(ACHIEVEMENTS,
-                     "RetroAchievements connection failed on image request.\n URL: {}",
-                     api_request.url);
         rc_api_destroy_request(&api_request);
-        update_event.Trigger(callback_data);
+        update_event.Trigger(fetch.callback_data);
         return;
       }
-
-      rc_api_destroy_request(&api_request);
-
+    }
+    else
+    {
       INFO_LOG_FMT(ACHIEVEMENTS, "Successfully downloaded badge id {}.", name_to_fetch);
 
-      if (!LoadPNGTexture(&tmp_badge, *http_response))
+      AchievementManager::Badge fetched_badge;
+      if (LoadPNGTexture(&fetched_badge, *http_response))
       {
-        ERROR_LOG_FMT(ACHIEVEMENTS, "Badge '{}' failed to load", name_to_fetch);
-        return;
+        tmp_badge = std::move(fetched_badge);
+        if (!WriteCacheFile(cache_path, *http_response))
+          WARN_LOG_FMT(ACHIEVEMENTS, "Failed to store badge '{}' to cache", name_to_fetch);
+        else
+          StoreCacheValidators(http_request, cache_path);
       }
-
-      std::string temp_path = fmt::format("{}.tmp", cache_path);
-      File::IOFile temp_file(temp_path, "wb");
-      if (!temp_file.IsOpen() ||
-          !temp_file.WriteBytes(http_response->data(), http_response->size()) ||
-          !temp_file.Close() || !File::Rename(temp_path, cache_path))
+      else if (!cached)
       {
-        File::Delete(temp_path);
-        WARN_LOG_FMT(ACHIEVEMENTS, "Failed to store badge '{}' to cache", name_to_fetch);
+        ERROR_LOG_FMT(ACHIEVEMENTS, "Badge '{}' failed to load", name_to_fetch);
+        rc_api_destroy_request(&api_request);
+        return;
       }
     }
+    rc_api_destroy_request(&api_request);
+  }
 
-    std::lock_guard lg{m_lock};
-    if (function(*this).empty() || name_to_fetch != function(*this))
-    {
-      INFO_LOG_FMT(ACHIEVEMENTS, "Requested outdated badge id {}.", name_to_fetch);
-      return;
-    }
+  std::lock_guard lg{m_lock};
+  if (fetch.function(*this).empty() || name_to_fetch != fetch.function(*this))
+  {
+    INFO_LOG_FMT(ACHIEVEMENTS, "Requested outdated badge id {}.", name_to_fetch);
+    return;
+  }
 
-    *badge = std::move(tmp_badge);
-    update_event.Trigger(callback_data);
-    if (badge_type == RC_IMAGE_TYPE_ACHIEVEMENT &&
-        m_active_challenges.contains(*callback_data.achievements.begin()))
-    {
-      m_challenges_updated = true;
-    }
-  });
+  *fetch.badge = std::move(tmp_badge);
+  update_event.Trigger(fetch.callback_data);
+  if (fetch.badge_type == RC_IMAGE_TYPE_ACHIEVEMENT &&
+      m_active_challenges.contains(*fetch.callback_data.achievements.begin()))
+  {
+    m_challenges_updated = true;
+  }
 }
 
 void AchievementManager::EventHandler(const rc_client_event_t* event, rc_client_t* client)
@@ -8,7 +8,9 @@
 #include <atomic>
 #include <chrono>
 #include <ctime>
+#include <deque>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -30,6 +32,7 @@
 #include "Common/Config/Config.h"
 #include "Common/HookableEvent.h"
 #include "Common/Lazy.h"
+#include "Common/PriorityWorkerPool.h"
 #include "Common/WorkQueueThread.h"
 #include "DiscIO/Volume.h"
 #include "VideoCommon/Assets/CustomTextureData.h"
@@ -40,6 +43,7 @@
 
 namespace Core
 {
+class CPUThreadGuard;
 class System;
 }  // namespace Core
 
@@ -82,6 +86,8 @@ public:
   static constexpr std::string_view GOLD = "#FFD700";
   static constexpr std::string_view BLUE = "#0B71C1";
   static constexpr std::string_view APPROVED_LIST_FILENAME = "ApprovedInis.json";
+  static constexpr std::string_view HASH_CACHE_FILENAME = "hashes.json";
+  static constexpr std::string_view CACHE_VALIDATORS_SUFFIX = ".validators";
   static const inline Common::SHA1::Digest APPROVED_LIST_HASH = {
       0xEA, 0x2F, 0x74, 0xA1, 0x6C, 0xF3, 0xB5, 0xD4, 0x8A, 0xAF,
       0x03, 0x30, 0x58, 0x2A, 0xE0, 0xF7, 0x0A, 0x88, 0x86, 0xB3};
@@ -113,6 +119,40 @@ public:
     bool rich_presence = false;
     int failed_login_code = 0;
   };
+
+  struct MemorySnapshotStats
+  {
+    u64 hits = 0;
+    u64 misses = 0;
+    u32 num_ranges = 0;
+    u32 size = 0;
+  };
+
+  struct EvaluationProfileEntry
+  {
+    enum class Type
+    {
+      Achievement,
+      Leaderboard,
+      RichPresence,
+    };
+
+    Type type;
+    AchievementId id;
+    std::string title;
+    u64 evaluations = 0;
+    u64 peeks = 0;
+    u64 bytes_read = 0;
+    std::chrono::nanoseconds time{};
+  };
+
+  struct EvaluationProfile
+  {
+    u64 frames = 0;
+    std::chrono::nanoseconds frame_time{};
+    std::vector<EvaluationProfileEntry> entries;
+  };
+
   Common::HookableEvent<const UpdatedItems&> update_event;
   Common::HookableEvent<int> login_event;
 
@@ -120,7 +160,7 @@ public:
   void Init(void* hwnd);
   void Login(const std::string& password);
   bool HasAPIToken() const;
-  void LoadGame(const DiscIO::Volume* volume);
+  void LoadGame(const DiscIO::Volume* volume, const std::string& file_path = "");
   void ChangeDisc(const DiscIO::Volume* volume);
   bool IsGameLoaded() const;
   void SetBackgroundExecutionAllowed(bool allowed);
@@ -167,6 +207,13 @@ public:
   void ResetChallengesUpdated();
   const std::unordered_set<AchievementId>& GetActiveChallenges() const;
   std::vector<std::string> GetActiveLeaderboards() const;
+  MemorySnapshotStats GetMemorySnapshotStats() const;
+
+  void SetEvaluationProfilingEnabled(bool enabled);
+  bool IsEvaluationProfilingEnabled() const;
+  void ResetEvaluationProfile();
+  EvaluationProfile GetEvaluationProfile() const;
+  bool DumpEvaluationProfile(const std::string& path) const;
 
 #ifdef RC_CLIENT_SUPPORTS_RAINTEGRATION
   Common::HookableEvent<> dev_menu_update_event;
@@ -184,10 +231,100 @@ public:
 private:
   AchievementManager() = default;
 
+  // Disc contents are read in large aligned blocks. While rcheevos hashes one block, the blocks
+  // after it are read and decompressed in parallel by a fixed set of workers, each block on its own
+  // copy of the volume.
+  static constexpr u64 FILEREADER_BLOCK_SIZE = 0x100000;
+  static constexpr size_t FILEREADER_READ_AHEAD_BLOCKS = 4;
+
+  struct FilereaderBlock
+  {
+    std::vector<u8> data;
+    std::unique_ptr<DiscIO::Volume> volume;
+  };
+
   struct FilereaderState
   {
     int64_t position = 0;
     std::unique_ptr<DiscIO::Volume> volume;
+    u64 block_offset = 0;
+    std::vector<u8> block;
+    std::deque<std::pair<u64, std::future<FilereaderBlock>>> prefetched_blocks;
+    std::vector<std::unique_ptr<DiscIO::Volume>> idle_volumes;
+    // Declared last so that its workers are done before the rest of the state is destroyed.
+    Common::PriorityWorkerPool<1> read_ahead_pool;
+  };
+
+  // Copy of the guest memory ranges the loaded set has read, captured once per frame so the
+  // condition reads performed by rc_client_do_frame don't have to touch the MMU. Ranges are learned
+  // from reads that miss the snapshot and dropped once they go unused. The snapshot is double
+  // buffered: reads are served from the front buffer while the next frame is captured into the
+  // back buffer, which lets evaluation run on another thread.
+  class MemorySnapshot
+  {
+  public:
+    using Reader = std::function<u32(u32 address, u8* buffer, u32 num_bytes)>;
+
+    bool Read(u32 address, u8* buffer, u32 num_bytes);
+    void RecordMiss(u32 address, u32 num_bytes);
+    bool HasPendingRanges() const { return !m_pending_ranges.empty(); }
+    void RebuildRanges();
+    void Capture(const Reader& reader);
+    void Swap();
+    void Clear();
+
+    MemorySnapshotStats GetStats() const;
+
+  private:
+    struct Range
+    {
+      u32 address;
+      u32 size;
+      std::array<u32, 2> valid_size;
+      size_t offset;
+      bool used;
+    };
+
+    std::vector<Range> m_ranges;
+    std::vector<std::pair<u32, u32>> m_pending_ranges;
+    std::array<std::vector<u8>, 2> m_buffers;
+    size_t m_front = 0;
+    u64 m_hits = 0;
+    u64 m_misses = 0;
+  };
+
+  // Measures what each achievement, leaderboard and rich presence script costs to evaluate.
+  // rc_client evaluates the whole set at once, so every definition is parsed again from the game
+  // data and evaluated on its own after the real frame, counting the memory it reads. Memory
+  // references shared between definitions are only read once by rc_client, so the per-definition
+  // costs don't add up to the frame time; they're meant to find the expensive definitions.
+  class EvaluationProfiler
+  {
+  public:
+    void Load(std::string_view game_data);
+    void Evaluate(rc_client_t* client);
+    void AddFrame(std::chrono::nanoseconds frame_time);
+    void Reset();
+    void Clear();
+
+    EvaluationProfile GetProfile() const;
+
+  private:
+    struct Definition
+    {
+      EvaluationProfileEntry entry;
+      std::vector<u8> buffer;
+      rc_trigger_t* trigger = nullptr;
+      rc_lboard_t* lboard = nullptr;
+      rc_richpresence_t* richpresence = nullptr;
+    };
+
+    static u32 Peek(u32 address, u32 num_bytes, void* userdata);
+
+    std::vector<Definition> m_definitions;
+    u64 m_frames = 0;
+    std::chrono::nanoseconds m_frame_time{};
+    EvaluationProfileEntry* m_current_entry = nullptr;
   };
 
   static picojson::value LoadApprovedList();
@@ -197,9 +334,17 @@ private:
   static int64_t FilereaderTell(void* file_handle);
   static size_t FilereaderRead(void* file_handle, void* buffer, size_t requested_bytes);
   static void FilereaderClose(void* file_handle);
+  static bool FilereaderLoadBlock(FilereaderState* state, u64 block_offset);
+  static void FilereaderPrefetch(FilereaderState* state);
+
+  static std::string LoadCachedHash(const std::string& file_path);
+  static void StoreCachedHash(const std::string& file_path, std::string_view hash);
 
   static u32 FindConsoleID(const DiscIO::Platform& platform);
 
+  // Hashes m_loading_volume and loads the game that the hash identifies.
+  void HashAndLoadGame();
+
   void LoadDefaultBadges();
   static void LoginCallback(int result, const char* error_message, rc_client_t* client,
                             void* userdata);
@@ -246,9 +391,26 @@ private:
 
   static void Request(const rc_api_request_t* request, rc_client_server_callback_t callback,
                       void* callback_data, rc_client_t* client);
+  static void PerformRequest(const std::string& url, const std::string& post_data,
+                             rc_client_server_callback_t callback, void* callback_data);
+  static u32 ReadMemory(Core::System& system, const Core::CPUThreadGuard& guard, u32 address,
+                        u8* buffer, u32 num_bytes);
+  static u32 ReadRAMUnsynchronized(Core::System& system, u32 address, u8* buffer, u32 num_bytes);
+  void CaptureMemorySnapshot(Core::System& system);
+  void EvaluateFrame();
   static u32 MemoryPeeker(u32 address, u8* buffer, u32 num_bytes, rc_client_t* client);
+  struct BadgeFetch
+  {
+    Badge* badge;
+    u32 badge_type;
+    BadgeNameFunction function;
+    UpdatedItems callback_data;
+  };
+
   void FetchBadge(Badge* badge, u32 badge_type, const BadgeNameFunction function,
                   const UpdatedItems callback_data);
+  void FetchBadges(std::vector<BadgeFetch> fetches);
+  void LoadBadge(const BadgeFetch& fetch);
   static void EventHandler(const rc_client_event_t* event, rc_client_t* client);
 
 #ifdef RC_CLIENT_SUPPORTS_RAINTEGRATION
@@ -263,6 +425,9 @@ private:
   rc_client_t* m_client{};
   std::atomic<Core::System*> m_system{};
   std::unique_ptr<DiscIO::Volume> m_loading_volume;
+  std::string m_loading_file_path;
+  // Whether the game is being loaded from a hash out of the hash cache rather than a computed one.
+  bool m_loading_with_cached_hash = false;
   Config::ConfigChangedCallbackID m_config_changed_callback_id;
   Badge m_default_player_badge;
   Badge m_default_game_badge;
@@ -277,6 +442,8 @@ private:
   RichPresence m_rich_presence;
   std::chrono::steady_clock::time_point m_last_rp_time = std::chrono::steady_clock::now();
   std::chrono::steady_clock::time_point m_last_progress_message = std::chrono::steady_clock::now();
+  // Incremented whenever queued badge fetches become outdated, so batches can stop early.
+  std::atomic<u32> m_badge_generation = 0;
 
   Common::Lazy<picojson::value> m_ini_root{LoadApprovedList};
 
@@ -285,14 +452,41 @@ private:
   std::unordered_set<AchievementId> m_active_challenges;
   std::vector<rc_client_leaderboard_tracker_t> m_active_leaderboards;
 
+  MemorySnapshot m_memory_snapshot;
+
+  // Raw game data response for the loaded game, which the evaluation profiler is built from.
+  std::string m_game_data_response;
+  bool m_evaluation_profiling_enabled = false;
+  EvaluationProfiler m_evaluation_profiler;
+
+  // Incremented whenever the rc_client progress may have changed. The last serialized progress is
+  // kept in m_progress_buffer, and reused as long as the generation matches.
+  u64 m_progress_generation = 0;
+  u64 m_progress_buffer_generation = ~u64{0};
+  std::vector<u8> m_progress_buffer;
+
   bool m_dll_found = false;
 #ifdef RC_CLIENT_SUPPORTS_RAINTEGRATION
   std::string m_title_estimate;
 #endif  // RC_CLIENT_SUPPORTS_RAINTEGRATION
 
-  Common::AsyncWorkThread m_queue;
-  Common::AsyncWorkThread m_image_queue;
+  // Priorities of the jobs in m_request_pool, from highest to lowest. Unlocks and leaderboard
+  // entries are never held up behind game data or badge downloads.
+  enum RequestPriority : std::size_t
+  {
+    REQUEST_PRIORITY_SUBMISSION,
+    REQUEST_PRIORITY_API,
+    REQUEST_PRIORITY_IMAGE,
+    REQUEST_PRIORITY_COUNT,
+  };
+  static constexpr std::size_t REQUEST_THREAD_COUNT = 3;
+
+  Common::PriorityWorkerPool<REQUEST_PRIORITY_COUNT> m_request_pool;
+  Common::AsyncWorkThread m_evaluation_queue;
+  // Hashes games whose cached hash was rejected, which takes too long for an rc_client callback.
+  Common::AsyncWorkThread m_hash_queue;
   mutable std::recursive_mutex m_lock;
+  std::mutex m_memory_snapshot_lock;
   std::recursive_mutex m_filereader_lock;
 };  // class AchievementManager
 
@@ -332,7 +526,7 @@ public:
     return code.enabled;
   }
 
-  constexpr void LoadGame(const DiscIO::Volume*) {}
+  constexpr void LoadGame(const DiscIO::Volume*, const std::string& = "") {}
 
   constexpr void ChangeDisc(const DiscIO::Volume*) {}
 
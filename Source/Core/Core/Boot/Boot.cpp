@@ -524,7 +524,7 @@ bool CBoot::BootUp(Core::System& system, const Core::CPUThreadGuard& guard,
       NOTICE_LOG_FMT(BOOT, "Booting from disc: {}", disc.path);
       const DiscIO::VolumeDisc* volume =
           SetDisc(system.GetDVDInterface(), std::move(disc.volume), disc.auto_disc_change_paths);
-      AchievementManager::GetInstance().LoadGame(volume);
+      AchievementManager::GetInstance().LoadGame(volume, disc.path);
 
       if (!volume)
         return false;
@@ -652,7 +652,7 @@ bool CBoot::BootUp(Core::System& system, const Core::CPUThreadGuard& guard,
                          ipl.disc->auto_disc_change_paths);
       }
 
-      AchievementManager::GetInstance().LoadGame(volume);
+      AchievementManager::GetInstance().LoadGame(volume, ipl.disc ? ipl.disc->path : "");
 
       SConfig::OnTitleDirectlyBooted(guard);
       return true;
@@ -28,6 +28,8 @@ const Info<bool> RA_DISCORD_PRESENCE_ENABLED{
     {System::Achievements, "Achievements", "DiscordPresenceEnabled"}, false};
 const Info<bool> RA_PROGRESS_ENABLED{{System::Achievements, "Achievements", "ProgressEnabled"},
                                      false};
+const Info<bool> RA_ASYNC_EVALUATION_ENABLED{
+    {System::Achievements, "Achievements", "AsyncEvaluationEnabled"}, false};
 }  // namespace Config
 
 #endif  // USE_RETRO_ACHIEVEMENTS
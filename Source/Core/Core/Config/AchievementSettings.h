@@ -22,6 +22,7 @@ extern const Info<bool> RA_LEADERBOARD_TRACKER_ENABLED;
 extern const Info<bool> RA_CHALLENGE_INDICATORS_ENABLED;
 extern const Info<bool> RA_DISCORD_PRESENCE_ENABLED;
 extern const Info<bool> RA_PROGRESS_ENABLED;
+extern const Info<bool> RA_ASYNC_EVALUATION_ENABLED;
 }  // namespace Config
 
 #endif  // USE_RETRO_ACHIEVEMENTS
@@ -97,6 +97,7 @@ extern const Info<int> GFX_SHADER_PRECOMPILER_THREADS;
 extern const Info<bool> GFX_SAVE_TEXTURE_CACHE_TO_STATE;
 extern const Info<bool> GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION;
 extern const Info<bool> GFX_CPU_CULL;
+extern const Info<bool> GFX_DISPLAY_LIST_CACHE;
 
 extern const Info<TriState> GFX_MTL_MANUALLY_UPLOAD_BUFFERS;
 extern const Info<TriState> GFX_MTL_USE_PRESENT_DRAWABLE;
@@ -104,6 +105,7 @@ extern const Info<TriState> GFX_MTL_USE_PRESENT_DRAWABLE;
 extern const Info<bool> GFX_SW_DUMP_OBJECTS;
 extern const Info<bool> GFX_SW_DUMP_TEV_STAGES;
 extern const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES;
+extern const Info<int> GFX_SW_RASTERIZER_THREADS;
 
 extern const Info<bool> GFX_PREFER_GLES;
 
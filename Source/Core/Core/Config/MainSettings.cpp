@@ -43,6 +43,9 @@ const Info<bool> MAIN_SKIP_IPL{{System::Main, "Core", "SkipIPL"}, true};
 const Info<PowerPC::CPUCore> MAIN_CPU_CORE{{System::Main, "Core", "CPUCore"},
                                            PowerPC::DefaultCPUCore()};
 const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"}, true};
+const Info<bool> MAIN_JIT_BLOCK_PROFILE{{System::Main, "Core", "JITBlockProfile"}, false};
+const Info<bool> MAIN_JIT_REGION_COMPILATION{{System::Main, "Core", "JITRegionCompilation"},
+                                             false};
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
 const Info<bool> MAIN_PAGE_TABLE_FASTMEM{{System::Main, "Core", "PageTableFastmem"}, true};
 const Info<bool> MAIN_FASTMEM_ARENA{{System::Main, "Core", "FastmemArena"}, true};
@@ -282,6 +285,13 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<std::string> MAIN_SAVESTATE_COMPRESSION{{System::Main, "Core", "SavestateCompression"},
+                                                   "LZ4"};
+const Info<int> MAIN_SAVESTATE_COMPRESSION_LEVEL{
+    {System::Main, "Core", "SavestateCompressionLevel"}, 5};
+const Info<bool> MAIN_REWIND_ENABLED{{System::Main, "Core", "EnableRewind"}, false};
+const Info<u32> MAIN_REWIND_FRAME_INTERVAL{{System::Main, "Core", "RewindFrameInterval"}, 30};
+const Info<u32> MAIN_REWIND_MEMORY_BUDGET{{System::Main, "Core", "RewindMemoryBudget"}, 256};
 const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS{
     {System::Main, "Core", "RealWiiRemoteRepeatReports"}, true};
 const Info<bool> MAIN_WII_WIILINK_ENABLE{{System::Main, "Core", "EnableWiiLink"}, false};
@@ -56,6 +56,10 @@ namespace Config
 extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+// Saves the blocks compiled in a session so they can be compiled early the next time.
+extern const Info<bool> MAIN_JIT_BLOCK_PROFILE;
+// Recompiles blocks that run very often with more branches followed, so that they cover more code.
+extern const Info<bool> MAIN_JIT_REGION_COMPILATION;
 extern const Info<bool> MAIN_FASTMEM;
 extern const Info<bool> MAIN_PAGE_TABLE_FASTMEM;
 extern const Info<bool> MAIN_FASTMEM_ARENA;
@@ -163,6 +167,15 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+// "LZ4" or "Zstd".
+extern const Info<std::string> MAIN_SAVESTATE_COMPRESSION;
+// Only used for zstd.
+extern const Info<int> MAIN_SAVESTATE_COMPRESSION_LEVEL;
+extern const Info<bool> MAIN_REWIND_ENABLED;
+// Number of frames between rewind snapshots.
+extern const Info<u32> MAIN_REWIND_FRAME_INTERVAL;
+// Memory budget for compressed rewind snapshots, in MiB.
+extern const Info<u32> MAIN_REWIND_MEMORY_BUDGET;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
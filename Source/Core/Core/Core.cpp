@@ -150,6 +150,8 @@ void FrameUpdateOnCPUThread()
 
 void OnFrameEnd(Core::System& system)
 {
+  ::State::UpdateRewindBuffer(system);
+
 #ifdef USE_MEMORYWATCHER
   if (s_memory_watcher)
   {
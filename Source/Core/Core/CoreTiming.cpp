@@ -4,7 +4,7 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
-#include <mutex>
+#include <bit>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,7 +14,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 #include "Common/ScopeGuard.h"
 
 #include "Core/AchievementManager.h"
@@ -40,6 +40,152 @@ static void EmptyTimedCallback(Core::System& system, u64 userdata, s64 cyclesLat
 {
 }
 
+// Offsets a time so that times compare the same way as unsigned values.
+static constexpr u64 TimeToKey(s64 time)
+{
+  return static_cast<u64>(time) ^ (u64{1} << 63);
+}
+
+static constexpr s64 KeyToTime(u64 key)
+{
+  return static_cast<s64>(key ^ (u64{1} << 63));
+}
+
+void TimingWheel::Insert(const Event& event)
+{
+  ++m_size;
+  const u64 key = TimeToKey(event.time);
+  if (key < m_now)
+  {
+    m_overdue.push_back(event);
+    std::ranges::push_heap(m_overdue, std::ranges::greater{});
+    return;
+  }
+  InsertIntoLevel(event, key);
+}
+
+void TimingWheel::InsertIntoLevel(const Event& event, u64 key)
+{
+  const u64 diff = key ^ m_now;
+  const int level = diff == 0 ? 0 : (63 - std::countl_zero(diff)) / SLOT_BITS;
+  const int slot = static_cast<int>((key >> (level * SLOT_BITS)) % NUM_SLOTS);
+  std::vector<Event>& events = m_levels[level].slots[slot];
+  if (level == 0)
+  {
+    // All events in a slot on the lowest level are due at the same time. Keep them sorted by
+    // descending fifo order so that the next one can be popped from the back.
+    events.insert(std::ranges::upper_bound(events, event.fifo_order, std::ranges::greater{},
+                                           &Event::fifo_order),
+                  event);
+  }
+  else
+  {
+    events.push_back(event);
+  }
+  m_levels[level].occupied |= u64{1} << slot;
+}
+
+s64 TimingWheel::GetNextTime() const
+{
+  if (!m_overdue.empty())
+    return m_overdue.front().time;
+
+  for (int level = 0; level < NUM_LEVELS; ++level)
+  {
+    const u64 occupied = m_levels[level].occupied;
+    if (occupied == 0)
+      continue;
+
+    // Slots on lower levels and earlier slots on the same level always hold earlier events.
+    const int slot = std::countr_zero(occupied);
+    if (level == 0)
+      return KeyToTime((m_now & ~u64{NUM_SLOTS - 1}) | static_cast<u64>(slot));
+    return std::ranges::min(m_levels[level].slots[slot], {}, &Event::time).time;
+  }
+
+  ASSERT_MSG(POWERPC, false, "GetNextTime called on an empty timing wheel");
+  return 0;
+}
+
+bool TimingWheel::PopDue(s64 time, Event* event)
+{
+  if (!m_overdue.empty())
+  {
+    if (m_overdue.front().time > time)
+      return false;
+    std::ranges::pop_heap(m_overdue, std::ranges::greater{});
+    *event = m_overdue.back();
+    m_overdue.pop_back();
+    --m_size;
+    return true;
+  }
+
+  const u64 key = TimeToKey(time);
+  while (true)
+  {
+    const auto level_it =
+        std::ranges::find_if(m_levels, [](const Level& level) { return level.occupied != 0; });
+    if (level_it == m_levels.end())
+      return false;
+
+    const int level = static_cast<int>(level_it - m_levels.begin());
+    const int slot = std::countr_zero(level_it->occupied);
+    const int shift = level * SLOT_BITS;
+    const u64 upper_mask =
+        shift + SLOT_BITS >= 64 ? 0 : ~((u64{1} << (shift + SLOT_BITS)) - 1);
+    const u64 slot_start = (m_now & upper_mask) | (static_cast<u64>(slot) << shift);
+    if (slot_start > key)
+      return false;
+
+    std::vector<Event>& events = level_it->slots[slot];
+    m_now = slot_start;
+    if (level == 0)
+    {
+      *event = events.back();
+      events.pop_back();
+      if (events.empty())
+        level_it->occupied &= ~(u64{1} << slot);
+      --m_size;
+      return true;
+    }
+
+    // The wheel has reached this slot, so spread its events out over the levels below.
+    m_cascade_buffer.swap(events);
+    level_it->occupied &= ~(u64{1} << slot);
+    for (const Event& cascaded_event : m_cascade_buffer)
+      InsertIntoLevel(cascaded_event, TimeToKey(cascaded_event.time));
+    m_cascade_buffer.clear();
+  }
+}
+
+void TimingWheel::Reset(s64 time)
+{
+  for (Level& level : m_levels)
+  {
+    for (; level.occupied != 0; level.occupied &= level.occupied - 1)
+      level.slots[std::countr_zero(level.occupied)].clear();
+  }
+  m_overdue.clear();
+  m_now = TimeToKey(time);
+  m_size = 0;
+}
+
+std::vector<Event> TimingWheel::GetSortedEvents() const
+{
+  std::vector<Event> events = m_overdue;
+  events.reserve(m_size);
+  for (const Level& level : m_levels)
+  {
+    for (u64 occupied = level.occupied; occupied != 0; occupied &= occupied - 1)
+    {
+      const std::vector<Event>& slot_events = level.slots[std::countr_zero(occupied)];
+      events.insert(events.end(), slot_events.begin(), slot_events.end());
+    }
+  }
+  std::ranges::sort(events);
+  return events;
+}
+
 CoreTimingManager::CoreTimingManager(Core::System& system) : m_system(system)
 {
 }
@@ -78,7 +224,7 @@ EventType* CoreTimingManager::RegisterEvent(const std::string& name, TimedCallba
 
 void CoreTimingManager::UnregisterAllEvents()
 {
-  ASSERT_MSG(POWERPC, m_event_queue.empty(), "Cannot unregister events with events pending");
+  ASSERT_MSG(POWERPC, m_event_queue.Empty(), "Cannot unregister events with events pending");
   m_event_types.clear();
 }
 
@@ -88,6 +234,7 @@ void CoreTimingManager::Init()
   m_globals.slice_length = MAX_SLICE_LENGTH;
   m_globals.global_timer = 0;
   m_idled_cycles = 0;
+  m_event_queue.Reset(0);
 
   // The time between CoreTiming being initialized and the first call to Advance() is considered
   // the slice boundary between slice -1 and slice 0. Dispatcher loops must call Advance() before
@@ -126,7 +273,6 @@ void CoreTimingManager::Shutdown()
 {
   m_core_state_changed_hook.reset();
 
-  std::lock_guard lk(m_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
@@ -171,7 +317,6 @@ void CoreTimingManager::RefreshConfig()
 
 void CoreTimingManager::DoState(PointerWrap& p)
 {
-  std::lock_guard lk(m_ts_write_lock);
   p.Do(m_globals.slice_length);
   p.Do(m_globals.global_timer);
   p.Do(m_idled_cycles);
@@ -186,7 +331,12 @@ void CoreTimingManager::DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
-  p.DoEachElement(m_event_queue, [this](PointerWrap& pw, Event& ev) {
+  // Events are stored in the order they will fire, so that the state doesn't depend on how the
+  // wheel happens to be laid out.
+  std::vector<Event> events;
+  if (!p.IsReadMode())
+    events = m_event_queue.GetSortedEvents();
+  p.DoEachElement(events, [this](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
 
@@ -221,10 +371,10 @@ void CoreTimingManager::DoState(PointerWrap& p)
 
   if (p.IsReadMode())
   {
-    // When loading from a save state, we must assume the Event order is random and meaningless.
-    // The exact layout of the heap in memory is implementation defined, therefore it is platform
-    // and library version specific.
-    std::ranges::make_heap(m_event_queue, std::ranges::greater{});
+    // Older save states stored the events in heap order, so don't rely on the order here.
+    m_event_queue.Reset(m_globals.global_timer);
+    for (const Event& ev : events)
+      m_event_queue.Insert(ev);
 
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
@@ -252,7 +402,7 @@ u64 CoreTimingManager::GetIdleTicks() const
 
 void CoreTimingManager::ClearPendingEvents()
 {
-  m_event_queue.clear();
+  m_event_queue.Reset(m_globals.global_timer);
 }
 
 void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
@@ -281,8 +431,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::ranges::push_heap(m_event_queue, std::ranges::greater{});
+    m_event_queue.Insert(Event{timeout, m_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -294,21 +443,13 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
                     *event_type->name);
     }
 
-    std::lock_guard lk(m_ts_write_lock);
     m_ts_queue.Push(Event{cycles_into_future, 0, userdata, event_type});
   }
 }
 
 void CoreTimingManager::RemoveEvent(EventType* event_type)
 {
-  const size_t erased =
-      std::erase_if(m_event_queue, [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (erased != 0)
-  {
-    std::ranges::make_heap(m_event_queue, std::ranges::greater{});
-  }
+  m_event_queue.RemoveIf([&](const Event& e) { return e.type == event_type; });
 }
 
 void CoreTimingManager::RemoveAllEvents(EventType* event_type)
@@ -332,15 +473,13 @@ void CoreTimingManager::ForceExceptionCheck(s64 cycles)
 
 void CoreTimingManager::MoveEvents()
 {
-  while (!m_ts_queue.Empty())
+  Event ev;
+  while (m_ts_queue.Pop(ev))
   {
-    auto& ev = m_event_queue.emplace_back(m_ts_queue.Front());
-    m_ts_queue.Pop();
-
     ev.fifo_order = m_event_fifo_id++;
     ev.time += m_globals.global_timer;
 
-    std::ranges::push_heap(m_event_queue, std::ranges::greater{});
+    m_event_queue.Insert(ev);
   }
 }
 
@@ -353,6 +492,9 @@ void CoreTimingManager::Advance()
   auto& power_pc = m_system.GetPowerPC();
   auto& ppc_state = power_pc.GetPPCState();
 
+  // PC is up to date here even when running a JIT, which makes this a good place to sample it.
+  power_pc.GetSamplingProfiler().OnTimingSlice();
+
   int cyclesExecuted = m_globals.slice_length - DowncountToCycles(ppc_state.downcount);
   m_globals.global_timer += cyclesExecuted;
   m_last_oc_factor = m_config_oc_factor;
@@ -361,21 +503,17 @@ void CoreTimingManager::Advance()
 
   m_is_global_timer_sane = true;
 
-  while (!m_event_queue.empty() && m_event_queue.front().time <= m_globals.global_timer)
-  {
-    Event evt = std::move(m_event_queue.front());
-    std::ranges::pop_heap(m_event_queue, std::ranges::greater{});
-    m_event_queue.pop_back();
+  Event evt;
+  while (m_event_queue.PopDue(m_globals.global_timer, &evt))
     evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
-  }
 
   m_is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
-  if (!m_event_queue.empty())
+  if (!m_event_queue.Empty())
   {
     m_globals.slice_length = static_cast<int>(
-        std::min<s64>(m_event_queue.front().time - m_globals.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(m_event_queue.GetNextTime() - m_globals.global_timer, MAX_SLICE_LENGTH));
   }
 
   ppc_state.downcount = CyclesToDowncount(m_globals.slice_length);
@@ -546,9 +684,7 @@ bool CoreTimingManager::UseSyncOnSkipIdle() const
 
 void CoreTimingManager::LogPendingEvents() const
 {
-  auto clone = m_event_queue;
-  std::ranges::sort(clone);
-  for (const Event& ev : clone)
+  for (const Event& ev : m_event_queue.GetSortedEvents())
   {
     INFO_LOG_FMT(POWERPC, "PENDING: Now: {} Pending: {} Type: {}", m_globals.global_timer, ev.time,
                  *ev.type->name);
@@ -564,10 +700,13 @@ void CoreTimingManager::AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clo
 
   m_system.GetPerfMetrics().AdjustClockSpeed(ticks, new_ppc_clock, old_ppc_clock);
 
-  for (Event& ev : m_event_queue)
+  std::vector<Event> events = m_event_queue.GetSortedEvents();
+  m_event_queue.Reset(ticks);
+  for (Event& ev : events)
   {
     const s64 ev_ticks = (ev.time - ticks) * new_ppc_clock / old_ppc_clock;
     ev.time = ticks + ev_ticks;
+    m_event_queue.Insert(ev);
   }
 }
 
@@ -592,15 +731,22 @@ std::string CoreTimingManager::GetScheduledEventsSummary() const
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = m_event_queue;
-  std::ranges::sort(clone);
-  for (const Event& ev : clone)
+  for (const Event& ev : m_event_queue.GetSortedEvents())
   {
     text += fmt::format("{} : {} {:016x}\n", *ev.type->name, ev.time, ev.userdata);
   }
+
+  const Common::MPSCQueueStats ts_stats = m_ts_queue.GetStats();
+  text += fmt::format("Off-thread queue: max depth {}, contention {}, overflows {}\n",
+                      ts_stats.max_depth, ts_stats.contention, ts_stats.overflows);
   return text;
 }
 
+Common::MPSCQueueStats CoreTimingManager::GetThreadSafeQueueStats() const
+{
+  return m_ts_queue.GetStats();
+}
+
 u32 CoreTimingManager::GetFakeDecStartValue() const
 {
   return m_fake_dec_start_value;
@@ -16,7 +16,9 @@
 // inside callback:
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
-#include <mutex>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -24,7 +26,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/HookableEvent.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 #include "Common/Timer.h"
 #include "Core/CPUThreadConfigCallback.h"
 
@@ -73,6 +75,77 @@ struct Event
   }
 };
 
+// Pending events, kept in a hierarchical timing wheel. Each level has 64 slots, and each slot on a
+// level spans 64 times as many cycles as a slot on the level below it. An event is kept on the
+// lowest level where its time and the wheel's current time share a slot span, and is moved down
+// when the wheel's time reaches its slot. Inserting is O(1), and an event moves down at most once
+// per level before it fires, so popping is amortized O(1) too.
+// Events are popped in (time, fifo_order) order, exactly like the heap this replaced, which keeps
+// the callback order deterministic.
+class TimingWheel
+{
+public:
+  bool Empty() const { return m_size == 0; }
+  size_t Size() const { return m_size; }
+
+  void Insert(const Event& event);
+
+  // Returns the time of the earliest event. The wheel must not be empty.
+  s64 GetNextTime() const;
+
+  // Removes the earliest event and returns true if it's due at or before the given time.
+  bool PopDue(s64 time, Event* event);
+
+  // Removes all events and moves the wheel to the given time.
+  void Reset(s64 time);
+
+  template <typename Predicate>
+  size_t RemoveIf(Predicate predicate)
+  {
+    size_t erased = std::erase_if(m_overdue, predicate);
+    if (erased != 0)
+      std::ranges::make_heap(m_overdue, std::ranges::greater{});
+    for (Level& level : m_levels)
+    {
+      for (u64 occupied = level.occupied; occupied != 0; occupied &= occupied - 1)
+      {
+        const int slot = std::countr_zero(occupied);
+        std::vector<Event>& events = level.slots[slot];
+        erased += std::erase_if(events, predicate);
+        if (events.empty())
+          level.occupied &= ~(u64{1} << slot);
+      }
+    }
+    m_size -= erased;
+    return erased;
+  }
+
+  // Returns a copy of all events, sorted in the order they will fire.
+  std::vector<Event> GetSortedEvents() const;
+
+private:
+  static constexpr int SLOT_BITS = 6;
+  static constexpr int NUM_SLOTS = 1 << SLOT_BITS;
+  static constexpr int NUM_LEVELS = (64 + SLOT_BITS - 1) / SLOT_BITS;
+
+  struct Level
+  {
+    std::array<std::vector<Event>, NUM_SLOTS> slots;
+    u64 occupied = 0;
+  };
+
+  void InsertIntoLevel(const Event& event, u64 key);
+
+  std::array<Level, NUM_LEVELS> m_levels;
+  // Events scheduled before the wheel's current time, as a min-heap.
+  std::vector<Event> m_overdue;
+  std::vector<Event> m_cascade_buffer;
+  // The wheel's current time, offset so that times compare correctly as unsigned values. No event
+  // on the wheel is earlier than this.
+  u64 m_now = 0;
+  size_t m_size = 0;
+};
+
 enum class FromThread
 {
   CPU,
@@ -141,6 +214,9 @@ public:
 
   std::string GetScheduledEventsSummary() const;
 
+  // Contention and depth of the queue that events scheduled from other threads go through.
+  Common::MPSCQueueStats GetThreadSafeQueueStats() const;
+
   void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock);
 
   u32 GetFakeDecStartValue() const;
@@ -180,17 +256,13 @@ private:
   std::unordered_map<std::string, EventType> m_event_types;
 
   // STATE_TO_SAVE
-  // The queue is a min-heap using std::ranges::make_heap/push_heap/pop_heap.
-  // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-  // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accommodated
-  // by the standard adaptor class.
-  std::vector<Event> m_event_queue;
+  TimingWheel m_event_queue;
   u64 m_event_fifo_id = 0;
-  std::mutex m_ts_write_lock;
 
-  // Event objects created from other threads.
+  // Event objects created from other threads, drained by the CPU thread without taking a lock.
   // The time value of each Event here is a cycles_into_future value.
-  Common::SPSCQueue<Event> m_ts_queue;
+  static constexpr std::size_t TS_QUEUE_CAPACITY = 1024;
+  Common::MPSCQueue<Event, TS_QUEUE_CAPACITY> m_ts_queue;
 
   float m_last_oc_factor = 0.0f;
 
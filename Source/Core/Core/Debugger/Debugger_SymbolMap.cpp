@@ -25,8 +25,7 @@ static bool IsStackBottom(const Core::CPUThreadGuard& guard, u32 addr)
   return !addr || !PowerPC::MMU::HostIsRAMAddress(guard, addr);
 }
 
-static void WalkTheStack(const Core::CPUThreadGuard& guard,
-                         const std::function<void(u32)>& stack_step)
+void WalkTheStack(const Core::CPUThreadGuard& guard, const std::function<void(u32)>& stack_step)
 {
   const auto& ppc_state = guard.GetSystem().GetPPCState();
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -24,6 +25,9 @@ struct CallstackEntry
   u32 vAddress = 0;
 };
 
+// Calls stack_step with the saved return address of each frame of the guest's stack, starting
+// with the innermost one.
+void WalkTheStack(const Core::CPUThreadGuard& guard, const std::function<void(u32)>& stack_step);
 bool GetCallstack(const Core::CPUThreadGuard& guard, std::vector<CallstackEntry>& output);
 void PrintCallstack(const Core::CPUThreadGuard& guard, Common::Log::LogType type,
                     Common::Log::LogLevel level);
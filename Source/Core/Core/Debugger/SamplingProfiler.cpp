@@ -0,0 +1,150 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/Debugger/SamplingProfiler.h"
+
+#include <algorithm>
+#include <ranges>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Core/Core.h"
+#include "Core/Debugger/Debugger_SymbolMap.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace Core
+{
+static std::string GetFrameName(const PPCSymbolDB& ppc_symbol_db, u32 address)
+{
+  const Common::Symbol* const symbol = ppc_symbol_db.GetSymbolFromAddr(address);
+  if (symbol == nullptr)
+    return fmt::format("{:08x}", address);
+
+  // Semicolons separate the frames of a collapsed stack.
+  std::string name = symbol->name;
+  std::ranges::replace(name, ';', ':');
+  return name;
+}
+
+SamplingProfiler::SamplingProfiler(System& system) : m_system(system)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+  Stop();
+}
+
+void SamplingProfiler::Start(std::chrono::microseconds interval)
+{
+  if (IsRunning())
+    return;
+
+  m_stop_event.Reset();
+  m_timer_thread = std::thread(&SamplingProfiler::TimerThread, this, interval);
+}
+
+void SamplingProfiler::Stop()
+{
+  if (!IsRunning())
+    return;
+
+  m_stop_event.Set();
+  m_timer_thread.join();
+  m_sample_requested.store(false, std::memory_order_relaxed);
+}
+
+void SamplingProfiler::Clear(const CPUThreadGuard&)
+{
+  m_samples.clear();
+  m_sample_count = 0;
+}
+
+std::size_t SamplingProfiler::GetSampleCount(const CPUThreadGuard&) const
+{
+  return m_sample_count;
+}
+
+void SamplingProfiler::TimerThread(std::chrono::microseconds interval)
+{
+  Common::SetCurrentThreadName("Sampling Profiler");
+
+  while (!m_stop_event.WaitFor(interval))
+    m_sample_requested.store(true, std::memory_order_relaxed);
+}
+
+void SamplingProfiler::TakeSample()
+{
+  m_sample_requested.store(false, std::memory_order_relaxed);
+
+  const auto& ppc_state = m_system.GetPPCState();
+  m_stack_buffer.clear();
+  m_stack_buffer.push_back(ppc_state.pc);
+  m_stack_buffer.push_back(LR(ppc_state));
+
+  const CPUThreadGuard guard(m_system);
+  Dolphin_Debugger::WalkTheStack(guard, [this](u32 return_address) {
+    // Point at the branch rather than the instruction after it.
+    m_stack_buffer.push_back(return_address - 4);
+  });
+
+  ++m_samples[m_stack_buffer];
+  ++m_sample_count;
+}
+
+bool SamplingProfiler::ExportCollapsedStacks(const CPUThreadGuard&,
+                                             const PPCSymbolDB& ppc_symbol_db,
+                                             const std::string& path) const
+{
+  // Different addresses within the same functions make up the same collapsed stack.
+  std::map<std::string, u64> collapsed_stacks;
+  std::vector<std::string> frames;
+  for (const auto& [stack, count] : m_samples)
+  {
+    frames.clear();
+    frames.push_back(GetFrameName(ppc_symbol_db, stack[0]));
+
+    // LR only tells who called the current function while it's a leaf function (or hasn't saved
+    // LR yet). Otherwise LR points into the function itself, or into the caller that the stack
+    // already contains.
+    std::string lr_name = GetFrameName(ppc_symbol_db, stack[1] - 4);
+    if (lr_name != frames.front() &&
+        (stack.size() < 3 || lr_name != GetFrameName(ppc_symbol_db, stack[2])))
+    {
+      frames.push_back(std::move(lr_name));
+    }
+
+    for (const u32 address : stack | std::views::drop(2))
+      frames.push_back(GetFrameName(ppc_symbol_db, address));
+
+    std::string line;
+    for (const std::string& frame : frames | std::views::reverse)
+    {
+      if (!line.empty())
+        line += ';';
+      line += frame;
+    }
+    collapsed_stacks[std::move(line)] += count;
+  }
+
+  File::IOFile file(path, "w");
+  if (!file)
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to open {} for writing", path);
+    return false;
+  }
+
+  for (const auto& [stack, count] : collapsed_stacks)
+  {
+    if (!file.WriteString(fmt::format("{} {}\n", stack, count)))
+      return false;
+  }
+
+  return true;
+}
+}  // namespace Core
@@ -0,0 +1,79 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+
+class PPCSymbolDB;
+
+namespace Core
+{
+class CPUThreadGuard;
+class System;
+}  // namespace Core
+
+namespace Core
+{
+// Finds out where emulated software spends its time, without the overhead of instrumenting every
+// JIT block like JitBlock::ProfileData does. A host timer thread periodically requests a sample,
+// which the CPU thread takes at the start of the next timing slice by recording PC, LR and the
+// return addresses on the guest's stack. Samples are symbolized when they're exported.
+class SamplingProfiler final
+{
+public:
+  static constexpr std::chrono::microseconds DEFAULT_INTERVAL{1000};
+
+  explicit SamplingProfiler(System& system);
+  ~SamplingProfiler();
+  SamplingProfiler(const SamplingProfiler&) = delete;
+  SamplingProfiler(SamplingProfiler&&) = delete;
+  SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+  SamplingProfiler& operator=(SamplingProfiler&&) = delete;
+
+  bool IsRunning() const { return m_timer_thread.joinable(); }
+  void Start(std::chrono::microseconds interval = DEFAULT_INTERVAL);
+  void Stop();
+
+  // These must be called with the CPU thread paused, or from the CPU thread.
+  void Clear(const CPUThreadGuard& guard);
+  std::size_t GetSampleCount(const CPUThreadGuard& guard) const;
+
+  // Writes one line per distinct call stack, made of the semicolon-separated function names from
+  // the outermost to the innermost frame followed by the number of samples. This is the collapsed
+  // stack format that flame graph tools take as input.
+  bool ExportCollapsedStacks(const CPUThreadGuard& guard, const PPCSymbolDB& ppc_symbol_db,
+                             const std::string& path) const;
+
+  // Called by the CPU thread at the start of every timing slice.
+  void OnTimingSlice()
+  {
+    if (m_sample_requested.load(std::memory_order_relaxed)) [[unlikely]]
+      TakeSample();
+  }
+
+private:
+  void TakeSample();
+  void TimerThread(std::chrono::microseconds interval);
+
+  System& m_system;
+
+  std::thread m_timer_thread;
+  Common::Event m_stop_event;
+  std::atomic<bool> m_sample_requested = false;
+
+  // Sample counts by raw stack: PC, then LR, then the stack's return addresses, innermost first.
+  std::map<std::vector<u32>, u64> m_samples;
+  std::size_t m_sample_count = 0;
+  std::vector<u32> m_stack_buffer;
+};
+}  // namespace Core
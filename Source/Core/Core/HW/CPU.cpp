@@ -33,6 +33,7 @@ void CPUManager::Init(PowerPC::CPUCore cpu_core)
 {
   m_system.GetPowerPC().Init(cpu_core);
   m_state = State::Stepping;
+  m_run_loop_state = State::Stepping;
 }
 
 void CPUManager::Shutdown()
@@ -122,6 +123,9 @@ void CPUManager::Run()
     ExecutePendingJobs(state_lock);
     CPUThreadConfigCallback::CheckForConfigChanges();
 
+    // Jobs from YieldToCPUThreadJob have run, so the run loop can continue.
+    m_run_loop_state = m_state;
+
     Common::Event gdb_step_sync_event;
     switch (m_state)
     {
@@ -138,11 +142,13 @@ void CPUManager::Run()
           power_pc.GetMemChecks().HasAny())
       {
         m_state = State::Stepping;
+        m_run_loop_state = State::Stepping;
         PowerPC::CoreMode old_mode = power_pc.GetMode();
         power_pc.SetMode(PowerPC::CoreMode::Interpreter);
         power_pc.SingleStep();
         power_pc.SetMode(old_mode);
         m_state = State::Running;
+        m_run_loop_state = State::Running;
       }
 
       // Enter a fast runloop
@@ -237,6 +243,7 @@ void CPUManager::Stop()
   // will stick permanently.
   std::unique_lock state_lock(m_state_change_lock);
   m_state = State::PowerDown;
+  m_run_loop_state = State::PowerDown;
   m_state_cpu_cvar.notify_one();
 
   while (m_state_cpu_thread_active)
@@ -260,7 +267,7 @@ State CPUManager::GetState() const
 
 const State* CPUManager::GetStatePtr() const
 {
-  return &m_state;
+  return &m_run_loop_state;
 }
 
 void CPUManager::Reset()
@@ -295,6 +302,7 @@ bool CPUManager::SetStateLocked(State s)
   if (s == State::Stepping)
     m_system.GetPowerPC().GetBreakPoints().ClearTemporary();
   m_state = s;
+  m_run_loop_state = s;
   return true;
 }
 
@@ -409,4 +417,15 @@ void CPUManager::AddCPUThreadJob(Common::MoveOnlyFunction<void()> function)
   m_pending_jobs.push(std::move(function));
 }
 
+void CPUManager::YieldToCPUThreadJob(Common::MoveOnlyFunction<void()> function)
+{
+  std::unique_lock state_lock(m_state_change_lock);
+  m_pending_jobs.push(std::move(function));
+
+  // Only make the run loop return. The CPU stays in the Running state as far as everyone else is
+  // concerned.
+  if (m_state == State::Running && !m_state_paused_and_locked)
+    m_run_loop_state = State::Stepping;
+}
+
 }  // namespace CPU
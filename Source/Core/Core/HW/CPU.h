@@ -84,6 +84,8 @@ public:
 
   // Direct State Access (Raw pointer for embedding into JIT Blocks)
   // Strictly read-only. A lock is required to change the value.
+  // This is the state that the run loops check, which also reads Stepping while a job from
+  // YieldToCPUThreadJob is waiting to run, so that the run loop returns to execute it.
   const State* GetStatePtr() const;
 
   // Locks the CPU Thread (waiting for it to become idle). While this lock is held, the CPU Thread
@@ -103,6 +105,11 @@ public:
   // PauseAndLock(), as while the CPU is in the run loop, it won't execute the function.
   void AddCPUThreadJob(Common::MoveOnlyFunction<void()> function);
 
+  // Adds a job to be executed on the CPU thread and, if the CPU is running, makes the run loop
+  // return at the next block boundary so that the job executes there. Emulation then resumes
+  // without pausing the adjacent systems or notifying the host, unlike Break().
+  void YieldToCPUThreadJob(Common::MoveOnlyFunction<void()> function);
+
 private:
   void FlushStepSyncEventLocked();
   void ExecutePendingJobs(std::unique_lock<std::mutex>& state_lock);
@@ -114,6 +121,9 @@ private:
   // Requires m_state_change_lock to modify the value.
   // Read access is unsynchronized.
   State m_state = State::PowerDown;
+  // What the run loops see through GetStatePtr(). Same as m_state, except that it's Stepping while
+  // a job from YieldToCPUThreadJob is pending.
+  State m_run_loop_state = State::PowerDown;
 
   // Synchronizes SetStepping and PauseAndLock so only one instance can be
   // active at a time. Simplifies code by eliminating several edge cases where
@@ -91,6 +91,11 @@ void DSPManager::DoState(PointerWrap& p)
   m_dsp_emulator->DoState(p);
 }
 
+std::size_t DSPManager::EstimateStateSize() const
+{
+  return m_aram.wii_mode ? 0 : m_aram.size;
+}
+
 void DSPManager::GlobalCompleteARAM(Core::System& system, u64 userdata, s64 cyclesLate)
 {
   system.GetDSP().CompleteARAM(userdata, cyclesLate);
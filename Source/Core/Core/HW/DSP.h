@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 #include "Common/CommonTypes.h"
@@ -87,6 +88,8 @@ public:
   DSPEmulator* GetDSPEmulator();
 
   void DoState(PointerWrap& p);
+  // Approximate size of the data written by DoState().
+  std::size_t EstimateStateSize() const;
 
   // TODO: Maybe rethink this? The timing is unpredictable.
   void GenerateDSPInterruptFromDSPEmu(DSPInterruptType type, int cycles_into_future = 0);
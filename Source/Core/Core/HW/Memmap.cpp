@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <chrono>
 #include <cstring>
 #include <map>
 #include <memory>
@@ -20,6 +21,7 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/DirtyPageTracker.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
 #include "Common/MsgHandler.h"
@@ -249,6 +251,7 @@ void MemoryManager::UpdateDBATMappings(const PowerPC::BatTable& dbat_table)
 {
   for (const auto& [logical_address, entry] : m_dbat_mapped_entries)
   {
+    SaveDirtyPagesOfView(entry);
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
   }
   m_dbat_mapped_entries.clear();
@@ -308,8 +311,8 @@ void MemoryManager::UpdateDBATMappings(const PowerPC::BatTable& dbat_table)
                             intersection_start, mapped_size, logical_address);
               continue;
             }
-            m_dbat_mapped_entries.emplace(logical_address,
-                                          LogicalMemoryView{mapped_pointer, mapped_size});
+            m_dbat_mapped_entries.emplace(
+                logical_address, LogicalMemoryView{mapped_pointer, mapped_size, position});
           }
 
           u32 bat_index = mapped_logical_address / PowerPC::BAT_PAGE_SIZE;
@@ -430,8 +433,8 @@ void MemoryManager::AddHostPageTableMapping(u32 logical_address, u32 translated_
                       intersection_start, mapped_size, logical_address);
         continue;
       }
-      m_page_table_mapped_entries.emplace(logical_address,
-                                          LogicalMemoryView{mapped_pointer, mapped_size});
+      m_page_table_mapped_entries.emplace(
+          logical_address, LogicalMemoryView{mapped_pointer, mapped_size, position});
     }
   }
 }
@@ -475,6 +478,7 @@ void MemoryManager::RemoveHostPageTableMapping(u32 logical_address)
   if (it != m_page_table_mapped_entries.end())
   {
     const LogicalMemoryView& entry = it->second;
+    SaveDirtyPagesOfView(entry);
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
 
     m_page_table_mapped_entries.erase(it);
@@ -485,6 +489,7 @@ void MemoryManager::RemoveAllPageTableMappings()
 {
   for (const auto& [logical_address, entry] : m_page_table_mapped_entries)
   {
+    SaveDirtyPagesOfView(entry);
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
   }
   m_page_table_mapped_entries.clear();
@@ -530,6 +535,33 @@ void MemoryManager::DoState(PointerWrap& p)
     return;
   }
 
+  if (!m_external_state_contents.empty())
+  {
+    if (p.IsReadMode())
+    {
+      for (const PhysicalMemoryRegion& region : m_physical_regions)
+      {
+        if (region.active)
+        {
+          std::memcpy(*region.out_pointer, m_external_state_contents.data() + region.shm_position,
+                      region.size);
+        }
+      }
+
+      // Memory now matches the external contents, so earlier writes no longer matter.
+      if (m_is_write_tracking_enabled)
+      {
+        std::vector<bool> discarded_pages;
+        CollectDirtyPages(discarded_pages);
+      }
+    }
+
+    p.DoMarker("Memory RAM");
+    p.DoMarker("Memory FakeVMEM");
+    p.DoMarker("Memory EXRAM");
+    return;
+  }
+
   p.DoArray(m_ram, current_ram_size);
   p.DoArray(m_l1_cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
@@ -541,9 +573,127 @@ void MemoryManager::DoState(PointerWrap& p)
   p.DoMarker("Memory EXRAM");
 }
 
+std::size_t MemoryManager::EstimateStateSize() const
+{
+  if (!m_external_state_contents.empty())
+    return 0;
+  return std::size_t(GetStatePageCount()) * STATE_PAGE_SIZE;
+}
+
+u32 MemoryManager::GetStatePageCount() const
+{
+  u32 size = 0;
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    if (region.active)
+      size += region.size;
+  }
+  return size / STATE_PAGE_SIZE;
+}
+
+u8* MemoryManager::GetStatePage(u32 index) const
+{
+  const u32 position = index * STATE_PAGE_SIZE;
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    if (region.active && position - region.shm_position < region.size)
+      return *region.out_pointer + (position - region.shm_position);
+  }
+  return nullptr;
+}
+
+bool MemoryManager::EnableWriteTracking()
+{
+  if (m_is_write_tracking_enabled)
+    return true;
+
+  if (!m_dirty_page_tracker)
+    m_dirty_page_tracker = std::make_unique<Common::DirtyPageTracker>();
+
+  m_is_write_tracking_enabled = m_dirty_page_tracker->Reset();
+  m_last_dirty_page_reset = std::chrono::steady_clock::now();
+  m_unmapped_dirty_pages.assign(GetStatePageCount(), false);
+  return m_is_write_tracking_enabled;
+}
+
+void MemoryManager::DisableWriteTracking()
+{
+  m_is_write_tracking_enabled = false;
+  m_unmapped_dirty_pages.clear();
+}
+
+void MemoryManager::CollectDirtyPages(std::vector<bool>& pages)
+{
+  const u32 page_count = GetStatePageCount();
+  if (!m_is_write_tracking_enabled)
+  {
+    pages.assign(page_count, true);
+    return;
+  }
+
+  pages = m_unmapped_dirty_pages;
+  std::fill(m_unmapped_dirty_pages.begin(), m_unmapped_dirty_pages.end(), false);
+
+  // Emulated memory can be written through the regular views, the physical fastmem views and the
+  // logical fastmem views, each of which has its own page table entries.
+  bool success = true;
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    if (!region.active)
+      continue;
+
+    const u32 first_page = region.shm_position / STATE_PAGE_SIZE;
+    success &= m_dirty_page_tracker->GetDirtyPages(*region.out_pointer, region.size, pages,
+                                                   first_page);
+    if (m_is_fastmem_arena_initialized)
+    {
+      success &= m_dirty_page_tracker->GetDirtyPages(m_physical_base + region.physical_address,
+                                                     region.size, pages, first_page);
+    }
+  }
+  for (const auto* entries : {&m_dbat_mapped_entries, &m_page_table_mapped_entries})
+  {
+    for (const auto& [logical_address, entry] : *entries)
+    {
+      success &= m_dirty_page_tracker->GetDirtyPages(entry.mapped_pointer, entry.mapped_size, pages,
+                                                     entry.shm_position / STATE_PAGE_SIZE);
+    }
+  }
+
+  // Pages that stay marked from an older tracking period are only compared again by the caller.
+  const auto now = std::chrono::steady_clock::now();
+  if (success && now - m_last_dirty_page_reset >= MIN_DIRTY_PAGE_RESET_INTERVAL)
+  {
+    success = m_dirty_page_tracker->Reset();
+    m_last_dirty_page_reset = now;
+  }
+
+  if (!success)
+  {
+    WARN_LOG_FMT(MEMMAP, "Dirty page tracking failed, disabling it");
+    DisableWriteTracking();
+    pages.assign(page_count, true);
+  }
+}
+
+void MemoryManager::SaveDirtyPagesOfView(const LogicalMemoryView& view)
+{
+  if (!m_is_write_tracking_enabled)
+    return;
+
+  if (!m_dirty_page_tracker->GetDirtyPages(view.mapped_pointer, view.mapped_size,
+                                           m_unmapped_dirty_pages,
+                                           view.shm_position / STATE_PAGE_SIZE))
+  {
+    WARN_LOG_FMT(MEMMAP, "Dirty page tracking failed, disabling it");
+    DisableWriteTracking();
+  }
+}
+
 void MemoryManager::Shutdown()
 {
   ShutdownFastmemArena();
+  DisableWriteTracking();
 
   m_is_initialized = false;
   for (const PhysicalMemoryRegion& region : m_physical_regions)
@@ -4,6 +4,8 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <set>
@@ -19,6 +21,10 @@
 
 // Global declarations
 class PointerWrap;
+namespace Common
+{
+class DirtyPageTracker;
+}
 namespace Core
 {
 class System;
@@ -56,6 +62,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 shm_position;
 };
 
 class MemoryManager
@@ -103,6 +110,34 @@ public:
   bool InitFastmemArena();
   void ShutdownFastmemArena();
   void DoState(PointerWrap& p);
+  // Approximate size of the data written by DoState().
+  std::size_t EstimateStateSize() const;
+
+  // Incremental savestates.
+  // The state pages are the 4 KiB pages of RAM, L1 cache, fake VMEM and EXRAM, numbered in the
+  // order DoState serializes them, which is also their order in the shared memory segment.
+  static constexpr u32 STATE_PAGE_SIZE = 0x1000;
+  u32 GetStatePageCount() const;
+  u8* GetStatePage(u32 index) const;
+
+  // Write tracking records which state pages get written through any view of emulated memory.
+  // Returns false if the host doesn't support it.
+  bool EnableWriteTracking();
+  void DisableWriteTracking();
+  bool IsWriteTrackingEnabled() const { return m_is_write_tracking_enabled; }
+
+  // Marks the state pages written since the previous call in `pages` (resized to the page count).
+  // Pages written shortly before the previous call may be marked again, because a new tracking
+  // period is started at most every MIN_DIRTY_PAGE_RESET_INTERVAL. Without write tracking, every
+  // page is marked. No other thread may write to emulated memory during the call.
+  void CollectDirtyPages(std::vector<bool>& pages);
+
+  // While set, DoState leaves the state pages out of the savestate, and loading copies them from
+  // `contents` instead, which must hold every state page in order.
+  void SetExternalStateContents(std::span<const u8> contents)
+  {
+    m_external_state_contents = contents;
+  }
 
   void UpdateDBATMappings(const PowerPC::BatTable& dbat_table);
   void AddPageTableMapping(u32 logical_address, u32 translated_address, bool writeable);
@@ -282,6 +317,17 @@ private:
   std::map<u32, std::vector<u32>> m_large_readable_pages;
   std::map<u32, std::vector<u32>> m_large_writeable_pages;
 
+  std::unique_ptr<Common::DirtyPageTracker> m_dirty_page_tracker;
+  bool m_is_write_tracking_enabled = false;
+  // Starting a tracking period affects the whole process (see DirtyPageTracker::Reset), so it isn't
+  // done for every snapshot when they're taken more often than this.
+  static constexpr std::chrono::milliseconds MIN_DIRTY_PAGE_RESET_INTERVAL{250};
+  std::chrono::steady_clock::time_point m_last_dirty_page_reset;
+  // Dirty bits of logical views that were unmapped during the current tracking period.
+  std::vector<bool> m_unmapped_dirty_pages;
+
+  std::span<const u8> m_external_state_contents;
+
   Core::System& m_system;
 
   static HostPageType GetHostPageTypeForPageSize(u32 page_size);
@@ -295,5 +341,6 @@ private:
   void RemoveLargePageTableMapping(u32 logical_address);
   void RemoveLargePageTableMapping(u32 logical_address, std::map<u32, std::vector<u32>>& map);
   void RemoveHostPageTableMapping(u32 logical_address);
+  void SaveDirtyPagesOfView(const LogicalMemoryView& view);
 };
 }  // namespace Memory
@@ -57,6 +57,7 @@ void CachedInterpreter::ExecuteOneBlock()
   const u8* normal_entry = m_block_cache.Dispatch();
   if (!normal_entry)
   {
+    m_block_cache.PrecompileProfiledBlocks(m_ppc_state.pc);
     Jit(m_ppc_state.pc);
     return;
   }
@@ -89,14 +90,12 @@ void CachedInterpreter::ExecuteOneBlock()
 
 void CachedInterpreter::Run()
 {
-  auto& core_timing = m_system.GetCoreTiming();
-
   const CPU::State* state_ptr = m_system.GetCPU().GetStatePtr();
   while (*state_ptr == CPU::State::Running)
   {
     // Start new timing slice
     // NOTE: Exceptions may change PC
-    core_timing.Advance();
+    AdvanceTiming(*this);
 
     do
     {
@@ -293,6 +292,10 @@ void CachedInterpreter::Jit(u32 em_address, bool clear_cache_and_retry_on_failur
       analyzer.Analyze(em_address, &code_block, &m_code_buffer, m_code_buffer.size());
   if (code_block.m_memory_exception)
   {
+    // Nothing is running the block yet when precompiling, so there's no exception to raise.
+    if (m_precompiling)
+      return;
+
     // Address of instruction could not be translated
     m_ppc_state.npc = nextPC;
     m_ppc_state.Exceptions |= EXCEPTION_ISI;
@@ -324,10 +327,17 @@ void CachedInterpreter::Jit(u32 em_address, bool clear_cache_and_retry_on_failur
 
       return;
     }
+
+    m_block_cache.EraseFailedBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
+    if (m_block_cache.EvictColdBlocks())
+    {
+      Jit(em_address, true);
+      return;
+    }
     WARN_LOG_FMT(DYNA_REC, "flushing code caches, please report if this happens a lot");
     ClearCache();
     Jit(em_address, false);
@@ -437,6 +447,11 @@ std::vector<JitBase::MemoryStats> CachedInterpreter::GetMemoryStats() const
   return {{"free", m_free_ranges.get_stats()}};
 }
 
+bool CachedInterpreter::IsCodeSpaceLow() const
+{
+  return IsAlmostFull() || IsFreeCodeSpaceLow(m_free_ranges);
+}
+
 std::size_t CachedInterpreter::DisassembleNearCode(const JitBlock& block,
                                                    std::ostream& stream) const
 {
@@ -47,6 +47,7 @@ public:
 
   void EraseSingleBlock(const JitBlock& block) override;
   std::vector<MemoryStats> GetMemoryStats() const override;
+  bool IsCodeSpaceLow() const override;
 
   static std::size_t Disassemble(const JitBlock& block, std::ostream& stream);
 
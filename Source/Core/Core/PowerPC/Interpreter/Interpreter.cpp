@@ -228,7 +228,7 @@ void Interpreter::Run()
   auto& core_timing = m_system.GetCoreTiming();
   auto& cpu = m_system.GetCPU();
   auto& power_pc = m_system.GetPowerPC();
-  while (cpu.GetState() == CPU::State::Running)
+  while (*cpu.GetStatePtr() == CPU::State::Running)
   {
     // CoreTiming Advance() ends the previous slice and declares the start of the next
     // one so it must always be called at the start. At boot, we are in slice -1 and must
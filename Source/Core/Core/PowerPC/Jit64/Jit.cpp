@@ -451,7 +451,7 @@ void Jit64::ImHere(Jit64& jit)
   been_here[ppc_state.pc] = 1;
 }
 
-bool Jit64::Cleanup()
+bool Jit64::Cleanup(BitSet32 registers_in_use)
 {
   bool did_something = false;
 
@@ -461,28 +461,28 @@ bool Jit64::Cleanup()
     SUB(64, R(RSCRATCH), PPCSTATE(gather_pipe_base_ptr));
     CMP(64, R(RSCRATCH), Imm32(GPFifo::GATHER_PIPE_SIZE));
     FixupBranch exit = J_CC(CC_L);
-    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_PushRegistersAndAdjustStack(registers_in_use, 0);
     ABI_CallFunctionP(GPFifo::UpdateGatherPipe, &m_system.GetGPFifo());
-    ABI_PopRegistersAndAdjustStack({}, 0);
+    ABI_PopRegistersAndAdjustStack(registers_in_use, 0);
     SetJumpTarget(exit);
     did_something = true;
   }
 
   if (m_ppc_state.feature_flags & FEATURE_FLAG_PERFMON)
   {
-    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_PushRegistersAndAdjustStack(registers_in_use, 0);
     ABI_CallFunctionCCCP(PowerPC::UpdatePerformanceMonitor, js.downcountAmount, js.numLoadStoreInst,
                          js.numFloatingPointInst, &m_ppc_state);
-    ABI_PopRegistersAndAdjustStack({}, 0);
+    ABI_PopRegistersAndAdjustStack(registers_in_use, 0);
     did_something = true;
   }
 
   if (IsProfilingEnabled())
   {
-    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_PushRegistersAndAdjustStack(registers_in_use, 0);
     ABI_CallFunctionPC(&JitBlock::ProfileData::EndProfiling, js.curBlock->profile_data.get(),
                        js.downcountAmount);
-    ABI_PopRegistersAndAdjustStack({}, 0);
+    ABI_PopRegistersAndAdjustStack(registers_in_use, 0);
     did_something = true;
   }
 
@@ -631,6 +631,52 @@ void Jit64::JustWriteExit(u32 destination, bool bl, u32 after)
   b->linkData.push_back(linkData);
 }
 
+void Jit64::WriteExitWithUnstoredRegisters(u32 destination, BitSet32 unstored_gprs,
+                                           BitSet32 unstored_fprs)
+{
+  JitBlock* b = js.curBlock;
+  b->skipped_exit_stores += (gpr.DirtyRegisters() & unstored_gprs).Count();
+  b->skipped_exit_stores += (fpr.DirtyRegisters() & unstored_fprs).Count();
+
+  Cleanup(CallerSavedRegistersInUse());
+
+  SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+  MOV(32, PPCSTATE(pc), Imm32(destination));
+
+  // Anything other than a linked block may read the registers, so the timing check and the
+  // dispatcher get them stored first.
+  const auto write_stores_and_jump = [&](const u8* target) {
+    const u8* start = GetCodePtr();
+    RCForkGuard gpr_guard = gpr.Fork();
+    RCForkGuard fpr_guard = fpr.Fork();
+    gpr.Flush(unstored_gprs);
+    fpr.Flush(unstored_fprs);
+    JMP(target);
+    return start;
+  };
+  SwitchToFarCode();
+  const u8* do_timing = write_stores_and_jump(asm_routines.do_timing);
+  const u8* dispatcher = write_stores_and_jump(asm_routines.dispatcher_no_timing_check);
+  SwitchToNearCode();
+
+  J_CC(CC_LE, do_timing);
+
+  JitBlock::LinkData linkData;
+  linkData.exitAddress = destination;
+  linkData.linkStatus = false;
+  linkData.call = false;
+  linkData.unstoredGPRs = unstored_gprs;
+  linkData.unstoredFPRs = unstored_fprs;
+  linkData.unlinkedTarget = dispatcher;
+  linkData.exitPtrs = GetWritableCodePtr();
+  // Padded for the same reason as in JustWriteExit.
+  JMP(dispatcher, true);
+  b->linkData.push_back(linkData);
+
+  gpr.Discard(unstored_gprs);
+  fpr.Discard(unstored_fprs);
+}
+
 void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
 {
   if (!m_enable_blr_optimization)
@@ -822,6 +868,8 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     }
   }
 
+  analyzer.SetRegionModeEnabled(js.regionAddresses.contains(em_address));
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
@@ -829,6 +877,10 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 
   if (code_block.m_memory_exception)
   {
+    // Nothing is running the block yet when precompiling, so there's no exception to raise.
+    if (m_precompiling)
+      return;
+
     // Address of instruction could not be translated
     m_ppc_state.npc = nextPC;
     m_ppc_state.Exceptions |= EXCEPTION_ISI;
@@ -870,12 +922,20 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 #endif
       return;
     }
+
+    blocks.EraseFailedBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
+    // Evict the least recently used blocks and retry, or if there are too few blocks for that to
+    // help, clear the entire JIT cache and retry.
+    if (blocks.EvictColdBlocks())
+    {
+      Jit(em_address, true);
+      return;
+    }
     WARN_LOG_FMT(DYNA_REC, "flushing code caches, please report if this happens a lot");
     ClearCache();
     Jit(em_address, false);
@@ -936,6 +996,26 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (IsProfilingEnabled())
     ABI_CallFunctionP(&JitBlock::ProfileData::BeginProfiling, b->profile_data.get());
 
+  // Count the runs of the block, and have it recompiled as a region once it gets hot.
+  if (IsRegionCompilationEnabled() && !js.regionAddresses.contains(js.blockStart))
+  {
+    b->region_countdown = REGION_COMPILATION_THRESHOLD;
+    b->region_countdown_start = m_system.GetCoreTiming().GetTicks();
+
+    SwitchToFarCode();
+    const u8* target = GetCodePtr();
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionP(JitBase::RecompileAsRegionFromJIT, this);
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check);
+    SwitchToNearCode();
+
+    MOV(64, R(RSCRATCH), ImmPtr(&b->region_countdown));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    J_CC(CC_Z, target);
+  }
+
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -1288,6 +1368,12 @@ std::vector<JitBase::MemoryStats> Jit64::GetMemoryStats() const
   return {{"near", m_free_ranges_near.get_stats()}, {"far", m_free_ranges_far.get_stats()}};
 }
 
+bool Jit64::IsCodeSpaceLow() const
+{
+  return trampolines.IsAlmostFull() || IsFreeCodeSpaceLow(m_free_ranges_near) ||
+         IsFreeCodeSpaceLow(m_free_ranges_far);
+}
+
 std::size_t Jit64::DisassembleNearCode(const JitBlock& block, std::ostream& stream) const
 {
   return m_disassembler->Disassemble(block.normalEntry, block.near_end, stream);
@@ -67,6 +67,7 @@ public:
 
   void EraseSingleBlock(const JitBlock& block) override;
   std::vector<MemoryStats> GetMemoryStats() const override;
+  bool IsCodeSpaceLow() const override;
 
   std::size_t DisassembleNearCode(const JitBlock& block, std::ostream& stream) const override;
   std::size_t DisassembleFarCode(const JitBlock& block, std::ostream& stream) const override;
@@ -102,6 +103,10 @@ public:
   void FakeBLCall(u32 after);
   void WriteExit(u32 destination, bool bl = false, u32 after = 0);
   void JustWriteExit(u32 destination, bool bl, u32 after);
+  // Like WriteExit, but leaves the given registers unstored if the exit gets linked to a block
+  // which overwrites them. The registers are discarded afterwards.
+  void WriteExitWithUnstoredRegisters(u32 destination, BitSet32 unstored_gprs,
+                                      BitSet32 unstored_fprs);
   void WriteExitDestInRSCRATCH(bool bl = false, u32 after = 0);
   void WriteBLRExit();
   void WriteExceptionExit();
@@ -112,7 +117,7 @@ public:
   void WriteBranchWatch(u32 origin, u32 destination, UGeckoInstruction inst, BitSet32 caller_save);
   void WriteBranchWatchDestInRSCRATCH(u32 origin, UGeckoInstruction inst, BitSet32 caller_save);
 
-  bool Cleanup();
+  bool Cleanup(BitSet32 registers_in_use = {});
 
   void GenerateConstantOverflow(bool overflow);
   void GenerateConstantOverflow(s64 val);
@@ -66,11 +66,11 @@ void Jit64AsmRoutineManager::Generate()
 
   const u8* outerLoop = GetCodePtr();
   ABI_PushRegistersAndAdjustStack({}, 0);
-  ABI_CallFunction(CoreTiming::GlobalAdvance);
+  ABI_CallFunctionP(JitBase::AdvanceTiming, &m_jit);
   ABI_PopRegistersAndAdjustStack({}, 0);
 
   // When we've just entered the jit we need to update the membase
-  // GlobalAdvance also checks exceptions after which we need to
+  // AdvanceTiming also checks exceptions after which we need to
   // update the membase so it makes sense to do this here.
   MOV(64, R(RMEM), PPCSTATE(mem_ptr));
 
@@ -131,10 +131,28 @@ void Jit64::bx(UGeckoInstruction inst)
     return;
   }
 
-  gpr.Flush();
-  fpr.Flush();
+  // Registers which the destination block overwrites before reading them can stay unstored, as
+  // long as the exit gets linked to that block.
+  BitSet32 unstored_gprs, unstored_fprs;
+  if (!inst.LK && !js.op->branchIsIdleLoop && jo.enableBlocklink && !IsDebuggingEnabled())
+  {
+    if (js.op->branchTo == js.blockStart)
+    {
+      unstored_gprs = code_block.m_gpr_overwritten;
+      unstored_fprs = code_block.m_fpr_overwritten;
+    }
+    else if (const JitBlock* destination =
+                 blocks.GetBlockFromStartAddress(js.op->branchTo, js.curBlock->feature_flags))
+    {
+      unstored_gprs = destination->overwritten_gprs;
+      unstored_fprs = destination->overwritten_fprs;
+    }
+  }
+
+  gpr.Flush(~unstored_gprs);
+  fpr.Flush(~unstored_fprs);
 
-  WriteBranchWatch<true>(js.compilerPC, js.op->branchTo, inst, {});
+  WriteBranchWatch<true>(js.compilerPC, js.op->branchTo, inst, CallerSavedRegistersInUse());
 #ifdef ACID_TEST
   if (inst.LK)
     AND(32, PPCSTATE(cr), Imm32(~(0xFF000000)));
@@ -143,6 +161,10 @@ void Jit64::bx(UGeckoInstruction inst)
   {
     WriteIdleExit(js.op->branchTo);
   }
+  else if (unstored_gprs || unstored_fprs)
+  {
+    WriteExitWithUnstoredRegisters(js.op->branchTo, unstored_gprs, unstored_fprs);
+  }
   else
   {
     WriteExit(js.op->branchTo, inst.LK, js.compilerPC + 4);
@@ -404,6 +404,17 @@ BitSet32 RegCache::RegistersInUse() const
   return result;
 }
 
+BitSet32 RegCache::DirtyRegisters() const
+{
+  BitSet32 result;
+  for (size_t i = 0; i < m_regs.size(); i++)
+  {
+    if (!m_regs[i].IsInDefaultLocation())
+      result[i] = true;
+  }
+  return result;
+}
+
 void RegCache::FlushX(X64Reg reg)
 {
   ASSERT_MSG(DYNA_REC, reg < m_xregs.size(), "Flushing non-existent reg {}",
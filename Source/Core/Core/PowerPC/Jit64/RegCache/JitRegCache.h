@@ -185,6 +185,8 @@ public:
 
   void PreloadRegisters(BitSet32 pregs);
   BitSet32 RegistersInUse() const;
+  // Which guest registers a Flush() would need to store.
+  BitSet32 DirtyRegisters() const;
 
 protected:
   friend class RCOpArg;
@@ -1012,6 +1012,8 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     }
   }
 
+  analyzer.SetRegionModeEnabled(js.regionAddresses.contains(em_address));
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
@@ -1019,6 +1021,10 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 
   if (code_block.m_memory_exception)
   {
+    // Nothing is running the block yet when precompiling, so there's no exception to raise.
+    if (m_precompiling)
+      return;
+
     // Address of instruction could not be translated
     m_ppc_state.npc = nextPC;
     m_ppc_state.Exceptions |= EXCEPTION_ISI;
@@ -1066,12 +1072,20 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 #endif
       return;
     }
+
+    blocks.EraseFailedBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
+    // Evict the least recently used blocks and retry, or if there are too few blocks for that to
+    // help, clear the entire JIT cache and retry.
+    if (blocks.EvictColdBlocks())
+    {
+      Jit(em_address, true);
+      return;
+    }
     WARN_LOG_FMT(DYNA_REC, "flushing code caches, please report if this happens a lot");
     ClearCache();
     Jit(em_address, false);
@@ -1097,6 +1111,16 @@ std::vector<JitBase::MemoryStats> JitArm64::GetMemoryStats() const
           {"far_1", m_free_ranges_far_1.get_stats()}};
 }
 
+bool JitArm64::IsCodeSpaceLow() const
+{
+  // Either code region can be used, see SetEmitterStateToFreeCodeRegion.
+  const bool region_0_low =
+      IsFreeCodeSpaceLow(m_free_ranges_near_0) || IsFreeCodeSpaceLow(m_free_ranges_far_0);
+  const bool region_1_low =
+      IsFreeCodeSpaceLow(m_free_ranges_near_1) || IsFreeCodeSpaceLow(m_free_ranges_far_1);
+  return region_0_low && region_1_low;
+}
+
 std::size_t JitArm64::DisassembleNearCode(const JitBlock& block, std::ostream& stream) const
 {
   return m_disassembler->Disassemble(block.normalEntry, block.near_end, stream);
@@ -1178,6 +1202,28 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (IsProfilingEnabled())
     ABI_CallFunction(&JitBlock::ProfileData::BeginProfiling, b->profile_data.get());
 
+  // Count the runs of the block, and have it recompiled as a region once it gets hot.
+  if (IsRegionCompilationEnabled() && !js.regionAddresses.contains(js.blockStart))
+  {
+    b->region_countdown = REGION_COMPILATION_THRESHOLD;
+    b->region_countdown_start = m_system.GetCoreTiming().GetTicks();
+
+    MOVP2R(ARM64Reg::X0, &b->region_countdown);
+    LDR(IndexType::Unsigned, ARM64Reg::W1, ARM64Reg::X0, 0);
+    SUB(ARM64Reg::W1, ARM64Reg::W1, 1);
+    STR(IndexType::Unsigned, ARM64Reg::W1, ARM64Reg::X0, 0);
+    FixupBranch not_hot = CBNZ(ARM64Reg::W1);
+    FixupBranch hot = B();
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    ABI_CallFunction(&JitBase::RecompileAsRegionFromJIT, this);
+    B(dispatcher_no_check);
+    SwitchToNearCode();
+    SetJumpTarget(not_hot);
+  }
+
   if (code_block.m_gqr_used.Count() == 1 && !js.pairedQuantizeAddresses.contains(js.blockStart))
   {
     int gqr = *code_block.m_gqr_used.begin();
@@ -52,6 +52,7 @@ public:
 
   void EraseSingleBlock(const JitBlock& block) override;
   std::vector<MemoryStats> GetMemoryStats() const override;
+  bool IsCodeSpaceLow() const override;
 
   std::size_t DisassembleNearCode(const JitBlock& block, std::ostream& stream) const override;
   std::size_t DisassembleFarCode(const JitBlock& block, std::ostream& stream) const override;
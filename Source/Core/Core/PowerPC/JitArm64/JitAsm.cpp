@@ -202,10 +202,10 @@ void JitArm64::GenerateAsm()
   FixupBranch exit = CBNZ(ARM64Reg::W8);
 
   SetJumpTarget(to_start_of_timing_slice);
-  ABI_CallFunction(&CoreTiming::GlobalAdvance);
+  ABI_CallFunction(&JitBase::AdvanceTiming, this);
 
   // When we've just entered the jit we need to update the membase
-  // GlobalAdvance also checks exceptions after which we need to
+  // AdvanceTiming also checks exceptions after which we need to
   // update the membase so it makes sense to do this here.
   EmitUpdateMembase();
 
@@ -58,7 +58,7 @@
 // After resetting the stack to the top, we call _resetstkoflw() to restore
 // the guard page at the 256kb mark.
 
-const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 25> JitBase::JIT_SETTINGS{{
+const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 26> JitBase::JIT_SETTINGS{{
     {&JitBase::bJITOff, &Config::MAIN_DEBUG_JIT_OFF},
     {&JitBase::bJITLoadStoreOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_OFF},
     {&JitBase::bJITLoadStorelXzOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_LXZ_OFF},
@@ -75,6 +75,7 @@ const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 25> JitB
     {&JitBase::m_enable_profiling, &Config::MAIN_DEBUG_JIT_ENABLE_PROFILING},
     {&JitBase::m_enable_debugging, &Config::MAIN_ENABLE_DEBUGGING},
     {&JitBase::m_enable_branch_following, &Config::MAIN_JIT_FOLLOW_BRANCH},
+    {&JitBase::m_enable_region_compilation, &Config::MAIN_JIT_REGION_COMPILATION},
     {&JitBase::m_enable_float_exceptions, &Config::MAIN_FLOAT_EXCEPTIONS},
     {&JitBase::m_enable_div_by_zero_exceptions, &Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS},
     {&JitBase::m_low_dcbz_hack, &Config::MAIN_LOW_DCBZ_HACK},
@@ -91,8 +92,42 @@ const u8* JitBase::Dispatch(JitBase& jit)
   return jit.GetBlockCache()->Dispatch();
 }
 
+void JitBase::AdvanceTiming(JitBase& jit)
+{
+  jit.GetBlockCache()->SampleBlockUse(jit.m_ppc_state.pc, jit.m_ppc_state.feature_flags);
+  jit.m_system.GetCoreTiming().Advance();
+}
+
+void JitBase::RecompileAsRegionFromJIT(JitBase& jit)
+{
+  const u32 address = jit.m_ppc_state.pc;
+  const u64 now = jit.m_system.GetCoreTiming().GetTicks();
+  JitBlock* const block =
+      jit.GetBlockCache()->GetBlockFromStartAddress(address, jit.m_ppc_state.feature_flags);
+  if (block && now - block->region_countdown_start > REGION_COMPILATION_WINDOW)
+  {
+    block->region_countdown = REGION_COMPILATION_THRESHOLD;
+    block->region_countdown_start = now;
+    return;
+  }
+
+  if (!jit.js.regionAddresses.insert(address).second)
+    return;
+
+  // Invalidate the block so that the dispatcher recompiles it in region mode.
+  jit.GetBlockCache()->InvalidateICache(address, 4, true);
+}
+
+void JitBase::Precompile(u32 em_address)
+{
+  m_precompiling = true;
+  Jit(em_address);
+  m_precompiling = false;
+}
+
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
+  jit.GetBlockCache()->PrecompileProfiledBlocks(em_address);
   jit.Jit(em_address);
 }
 
@@ -302,3 +337,14 @@ bool JitBase::ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op
   else
     return false;
 }
+
+bool JitBase::IsFreeCodeSpaceLow(const Common::RangeSizeSet<u8*>& free_ranges)
+{
+  // Far bigger than any block, but a small part of any code region.
+  constexpr std::size_t LOW_CODE_SPACE = 1024 * 1024;
+
+  const auto largest = free_ranges.by_size_begin();
+  if (largest == free_ranges.by_size_end())
+    return true;
+  return static_cast<std::size_t>(largest.to() - largest.from()) < LOW_CODE_SPACE;
+}
@@ -15,6 +15,7 @@
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/Config/ConfigInfo.h"
+#include "Common/RangeSizeSet.h"
 #include "Common/x64Emitter.h"
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/ConfigManager.h"
@@ -131,6 +132,8 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    // Blocks that ran often enough to be recompiled as regions.
+    std::unordered_set<u32> regionAddresses;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -154,6 +157,7 @@ protected:
   bool m_enable_profiling = false;
   bool m_enable_debugging = false;
   bool m_enable_branch_following = false;
+  bool m_enable_region_compilation = false;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
   bool m_low_dcbz_hack = false;
@@ -168,7 +172,11 @@ protected:
   bool m_cleanup_after_stackfault = false;
   u8* m_stack_guard = nullptr;
 
-  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 25> JIT_SETTINGS;
+  // Set while compiling a block from the block profile that isn't about to run. Such a block is
+  // dropped if its code can't be read, instead of raising an ISI exception.
+  bool m_precompiling = false;
+
+  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 26> JIT_SETTINGS;
 
   bool DoesConfigNeedRefresh() const;
   void RefreshConfig();
@@ -192,6 +200,9 @@ protected:
 
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op) const;
 
+  // Whether the largest free range of a code region is too small for IsCodeSpaceLow.
+  static bool IsFreeCodeSpaceLow(const Common::RangeSizeSet<u8*>& free_ranges);
+
 public:
   explicit JitBase(Core::System& system);
   JitBase(const JitBase&) = delete;
@@ -202,22 +213,46 @@ public:
 
   bool IsProfilingEnabled() const { return m_enable_profiling && m_enable_debugging; }
   bool IsDebuggingEnabled() const { return m_enable_debugging; }
+  // Regions are made by following more branches, which is pointless if branches aren't followed.
+  bool IsRegionCompilationEnabled() const
+  {
+    return m_enable_region_compilation && m_enable_branch_following && !m_enable_debugging;
+  }
   bool IsBranchWatchEnabled() const
   {
     auto& branch_watch = m_system.GetPowerPC().GetBranchWatch();
     return branch_watch.GetRecordingActive();
   }
 
+  // Number of runs after which a block is recompiled as a region, if they all happened within
+  // REGION_COMPILATION_WINDOW CPU cycles. Otherwise the count starts over, so that blocks which
+  // only pile up runs over a long time don't qualify. A region is compiled like any other block,
+  // except that more branches are followed (see PPCAnalyzer::SetRegionModeEnabled). Loop
+  // back-edges still leave it, so registers aren't kept across iterations.
+  static constexpr u32 REGION_COMPILATION_THRESHOLD = 0x1000;
+  static constexpr u64 REGION_COMPILATION_WINDOW = 0x1000000;
+
   static const u8* Dispatch(JitBase& jit);
+  // Starts a new timing slice. The dispatchers call this rather than CoreTiming directly, so that
+  // the block which is about to run can be sampled for JitBaseBlockCache::EvictColdBlocks.
+  static void AdvanceTiming(JitBase& jit);
+  // Called by a block that counted down REGION_COMPILATION_THRESHOLD runs, with PC set to its
+  // start. Either restarts the count or has the block recompiled as a region.
+  static void RecompileAsRegionFromJIT(JitBase& jit);
   virtual JitBaseBlockCache* GetBlockCache() = 0;
 
   virtual void Jit(u32 em_address) = 0;
+  // Compiles a block ahead of time, without raising exceptions if its code can't be read.
+  void Precompile(u32 em_address);
 
   virtual void EraseSingleBlock(const JitBlock& block) = 0;
 
   // Memory region name, free size, and fragmentation ratio
   using MemoryStats = std::pair<std::string_view, std::pair<std::size_t, double>>;
   virtual std::vector<MemoryStats> GetMemoryStats() const = 0;
+  // Whether so little contiguous code space is left that compiling blocks which aren't about to
+  // run would soon force blocks out of the cache.
+  virtual bool IsCodeSpaceLow() const = 0;
 
   virtual std::size_t DisassembleNearCode(const JitBlock& block, std::ostream& stream) const = 0;
   virtual std::size_t DisassembleFarCode(const JitBlock& block, std::ostream& stream) const = 0;
@@ -14,14 +14,20 @@
 #include <utility>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/IOFile.h"
 #include "Common/JitRegister.h"
+#include "Common/Logging/Log.h"
 #include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/Host.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -29,6 +35,42 @@
 
 using namespace Gen;
 
+namespace
+{
+constexpr u32 BLOCK_PROFILE_MAGIC = 0x46504A44;  // "DJPF"
+constexpr u32 BLOCK_PROFILE_VERSION = 1;
+
+// Only the most used blocks are saved, to bound the time spent precompiling.
+constexpr std::size_t MAX_PROFILED_BLOCKS = 0x10000;
+// Blocks that don't match memory are retried a few times, since the game may not have loaded the
+// code yet when the first precompile pass happens.
+constexpr u32 MAX_PRECOMPILE_ATTEMPTS = 4;
+// A precompile pass is spread over many block compilations, so that no single one of them stalls
+// the game for long.
+constexpr std::size_t MAX_PRECOMPILED_BLOCKS_PER_CALL = 0x100;
+// Sanity limit for reading profiles. Blocks rarely span more than a few ranges.
+constexpr u32 MAX_PROFILED_BLOCK_RANGES = 0x100;
+
+struct BlockProfileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 block_count;
+};
+
+struct ProfiledBlockHeader
+{
+  u32 effective_address;
+  u32 physical_address;
+  u32 feature_flags;
+  u32 code_crc;
+  u64 run_count;
+  u32 range_count;
+  u32 padding;
+};
+static_assert(sizeof(ProfiledBlockHeader) == 32);
+}  // namespace
+
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
   return physical_addresses.overlaps(address, address + length);
@@ -63,10 +105,27 @@ void JitBaseBlockCache::Init()
 #endif
 
   Clear();
+  m_code_space_stats = {};
+
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (Config::Get(Config::MAIN_JIT_BLOCK_PROFILE) && !game_id.empty())
+  {
+    m_block_profile_path = File::GetUserPath(D_CACHE_IDX) + game_id + ".jitprofile";
+    LoadBlockProfile();
+  }
 }
 
 void JitBaseBlockCache::Shutdown()
 {
+  if (!m_block_profile_path.empty())
+  {
+    RecordBlockProfile();
+    SaveBlockProfile();
+  }
+  m_block_profile_path.clear();
+  m_block_profile.clear();
+  ClearPendingProfiledBlocks();
+
   Common::JitRegister::Shutdown();
 
   m_entry_points_arena.Release();
@@ -82,6 +141,8 @@ void JitBaseBlockCache::Clear()
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
   m_jit.js.noSpeculativeConstantsAddresses.clear();
+  m_jit.js.regionAddresses.clear();
+  RecordBlockProfile();
   for (auto& e : block_map)
   {
     DestroyBlock(e.second);
@@ -158,6 +219,9 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   block.fast_block_map_index = index;
 
   block.physical_addresses = code_block.m_physical_addresses;
+  block.overwritten_gprs = code_block.m_gpr_overwritten;
+  block.overwritten_fprs = code_block.m_fpr_overwritten;
+  block.last_used = m_block_use_clock;
 
   block.originalSize = code_block.m_num_instructions;
   if (m_jit.IsDebuggingEnabled())
@@ -343,6 +407,7 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
         m_jit.js.noSpeculativeConstantsAddresses.erase(i);
+        m_jit.js.regionAddresses.erase(i);
       }
     }
   }
@@ -422,11 +487,287 @@ void JitBaseBlockCache::EraseSingleBlock(const JitBlock& block)
   block_map.erase(block_map_iter);  // The original JitBlock reference is now dangling.
 }
 
+void JitBaseBlockCache::EraseFailedBlock(const JitBlock& block)
+{
+  // Unfinalized blocks aren't linked, aren't in the fast block map and don't own any code space,
+  // so there's nothing to destroy.
+  const auto equal_range = block_map.equal_range(block.physicalAddress);
+  const auto block_map_iter = std::ranges::find(equal_range.first, equal_range.second, &block,
+                                                [](const auto& kv) { return &kv.second; });
+  if (block_map_iter != equal_range.second)
+    block_map.erase(block_map_iter);
+}
+
+bool JitBaseBlockCache::EvictColdBlocks()
+{
+  if (block_map.size() < MIN_BLOCKS_FOR_EVICTION)
+  {
+    ++m_code_space_stats.full_flushes;
+    return false;
+  }
+
+  std::vector<const JitBlock*> cold_blocks;
+  cold_blocks.reserve(block_map.size());
+  for (const auto& [physical_address, block] : block_map)
+    cold_blocks.push_back(&block);
+
+  const auto middle = cold_blocks.begin() + cold_blocks.size() / 2;
+  std::ranges::nth_element(cold_blocks, middle, {}, &JitBlock::last_used);
+  cold_blocks.erase(middle, cold_blocks.end());
+
+  for (const JitBlock* block : cold_blocks)
+    EraseSingleBlock(*block);
+
+  ++m_code_space_stats.partial_evictions;
+  m_code_space_stats.evicted_blocks += cold_blocks.size();
+  INFO_LOG_FMT(DYNA_REC, "Evicted {} cold blocks to free up code space", cold_blocks.size());
+
+  Host_JitCacheInvalidation();
+  return true;
+}
+
+void JitBaseBlockCache::SampleBlockUse(u32 em_address, CPUEmuFeatureFlags feature_flags)
+{
+  ++m_block_use_clock;
+  if (JitBlock* block = GetBlockFromStartAddress(em_address, feature_flags))
+    block->last_used = m_block_use_clock;
+}
+
 u32* JitBaseBlockCache::GetBlockBitSet() const
 {
   return valid_block.m_valid_block.get();
 }
 
+void JitBaseBlockCache::PrecompileProfiledBlocks(u32 em_address)
+{
+  // The game has most likely just loaded the code that was profiled when it runs one of its
+  // blocks, so start compiling all of it instead of one block at a time as it runs for the first
+  // time. The pass then goes on a few blocks at a time whenever a block gets compiled.
+  if (!m_precompile_pass_active)
+  {
+    if (!m_pending_profiled_addresses.contains(em_address))
+      return;
+    m_precompile_pass_active = true;
+    m_pending_profiled_addresses.clear();
+  }
+
+  // Blocks compiled while debugging or without a block cache differ from normal ones.
+  if (m_jit.IsDebuggingEnabled() || SConfig::GetInstance().bJITNoBlockCache)
+  {
+    ClearPendingProfiledBlocks();
+    return;
+  }
+
+  const CPUEmuFeatureFlags feature_flags = m_jit.m_ppc_state.feature_flags;
+  std::size_t compiled_count = 0;
+  std::size_t attempted_count = 0;
+  while (m_next_profiled_block < m_pending_profiled_blocks.size() &&
+         attempted_count < MAX_PRECOMPILED_BLOCKS_PER_CALL)
+  {
+    ProfiledBlock& block = m_pending_profiled_blocks[m_next_profiled_block];
+    const u32 address = block.effective_address;
+    if (block.feature_flags == feature_flags)
+    {
+      // The caller compiles the block it's about to run.
+      if (address == em_address || GetBlockFromStartAddress(address, feature_flags))
+      {
+        ++m_next_profiled_block;
+        continue;
+      }
+
+      if (IsProfiledBlockValid(block))
+      {
+        // Blocks that are about to run shouldn't be pushed out of the cache by ones that might not.
+        if (m_jit.IsCodeSpaceLow())
+        {
+          INFO_LOG_FMT(DYNA_REC,
+                       "Stopped precompiling the block profile with {} blocks left, code space "
+                       "is running low",
+                       m_pending_profiled_blocks.size() - m_next_profiled_block +
+                           m_retried_profiled_blocks.size());
+          ClearPendingProfiledBlocks();
+          return;
+        }
+
+        // A block whose code can't be read anymore is dropped rather than tried again.
+        ++attempted_count;
+        ++m_next_profiled_block;
+        m_jit.Precompile(address);
+        if (GetBlockFromStartAddress(address, feature_flags))
+          ++compiled_count;
+        continue;
+      }
+    }
+
+    if (++block.failed_attempts < MAX_PRECOMPILE_ATTEMPTS)
+    {
+      m_pending_profiled_addresses.insert(address);
+      m_retried_profiled_blocks.push_back(std::move(block));
+    }
+    ++m_next_profiled_block;
+  }
+
+  if (m_next_profiled_block == m_pending_profiled_blocks.size())
+  {
+    // The blocks that didn't match memory wait for the next time the game runs one of them.
+    m_pending_profiled_blocks = std::move(m_retried_profiled_blocks);
+    m_retried_profiled_blocks.clear();
+    m_next_profiled_block = 0;
+    m_precompile_pass_active = false;
+  }
+
+  INFO_LOG_FMT(DYNA_REC, "Precompiled {} blocks from the block profile, {} still pending",
+               compiled_count,
+               m_pending_profiled_blocks.size() - m_next_profiled_block +
+                   m_retried_profiled_blocks.size());
+}
+
+void JitBaseBlockCache::ClearPendingProfiledBlocks()
+{
+  m_pending_profiled_blocks.clear();
+  m_retried_profiled_blocks.clear();
+  m_pending_profiled_addresses.clear();
+  m_next_profiled_block = 0;
+  m_precompile_pass_active = false;
+}
+
+void JitBaseBlockCache::LoadBlockProfile()
+{
+  File::IOFile file(m_block_profile_path, "rb");
+  BlockProfileHeader header;
+  if (!file.ReadArray(&header, 1))
+    return;
+
+  if (header.magic != BLOCK_PROFILE_MAGIC || header.version != BLOCK_PROFILE_VERSION)
+  {
+    WARN_LOG_FMT(DYNA_REC, "Ignoring block profile {} with an unknown format",
+                 m_block_profile_path);
+    return;
+  }
+
+  m_pending_profiled_blocks.reserve(std::min<std::size_t>(header.block_count, MAX_PROFILED_BLOCKS));
+  for (u32 i = 0; i < header.block_count; ++i)
+  {
+    ProfiledBlockHeader block_header;
+    if (!file.ReadArray(&block_header, 1) || block_header.range_count > MAX_PROFILED_BLOCK_RANGES)
+      break;
+
+    std::vector<PhysicalRange> physical_ranges(block_header.range_count);
+    if (!file.ReadArray(physical_ranges.data(), physical_ranges.size()))
+      break;
+
+    m_pending_profiled_addresses.insert(block_header.effective_address);
+    m_pending_profiled_blocks.push_back(
+        {.effective_address = block_header.effective_address,
+         .physical_address = block_header.physical_address,
+         .feature_flags = static_cast<CPUEmuFeatureFlags>(block_header.feature_flags),
+         .code_crc = block_header.code_crc,
+         .run_count = block_header.run_count,
+         .physical_ranges = std::move(physical_ranges)});
+  }
+
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} blocks from block profile {}",
+               m_pending_profiled_blocks.size(), m_block_profile_path);
+}
+
+void JitBaseBlockCache::SaveBlockProfile() const
+{
+  std::vector<const ProfiledBlock*> blocks;
+  blocks.reserve(m_block_profile.size());
+  for (const auto& [key, block] : m_block_profile)
+    blocks.push_back(&block);
+
+  // Blocks are only profiled when JIT profiling is enabled. Otherwise all run counts are 0, and
+  // blocks are saved in address order.
+  const std::size_t block_count = std::min(blocks.size(), MAX_PROFILED_BLOCKS);
+  std::ranges::stable_sort(blocks, std::ranges::greater{}, &ProfiledBlock::run_count);
+  blocks.resize(block_count);
+
+  File::CreateFullPath(m_block_profile_path);
+  File::IOFile file(m_block_profile_path, "wb");
+  const BlockProfileHeader header{.magic = BLOCK_PROFILE_MAGIC,
+                                  .version = BLOCK_PROFILE_VERSION,
+                                  .block_count = static_cast<u32>(block_count)};
+  bool success = file.WriteArray(&header, 1);
+  for (const ProfiledBlock* block : blocks)
+  {
+    const ProfiledBlockHeader block_header{
+        .effective_address = block->effective_address,
+        .physical_address = block->physical_address,
+        .feature_flags = block->feature_flags,
+        .code_crc = block->code_crc,
+        .run_count = block->run_count,
+        .range_count = static_cast<u32>(block->physical_ranges.size()),
+        .padding = 0};
+    success = success && file.WriteArray(&block_header, 1) &&
+              file.WriteArray(block->physical_ranges.data(), block->physical_ranges.size());
+  }
+
+  if (!success)
+    ERROR_LOG_FMT(DYNA_REC, "Failed to write block profile {}", m_block_profile_path);
+}
+
+void JitBaseBlockCache::RecordBlockProfile()
+{
+  if (m_block_profile_path.empty())
+    return;
+
+  for (const auto& [physical_address, block] : block_map)
+  {
+    std::vector<PhysicalRange> physical_ranges;
+    for (auto [range_start, range_end] : block.physical_addresses)
+      physical_ranges.push_back({range_start, range_end});
+
+    const std::optional<u32> code_crc = GetCodeCRC(physical_ranges);
+    if (!code_crc)
+      continue;
+
+    ProfiledBlock& profiled_block =
+        m_block_profile[{block.effectiveAddress, block.feature_flags}];
+    profiled_block.effective_address = block.effectiveAddress;
+    profiled_block.physical_address = physical_address;
+    profiled_block.feature_flags = block.feature_flags;
+    profiled_block.code_crc = *code_crc;
+    profiled_block.physical_ranges = std::move(physical_ranges);
+    // Run counts restart from 0 every time the cache is cleared.
+    if (block.profile_data)
+      profiled_block.run_count += block.profile_data->run_count;
+  }
+}
+
+std::optional<u32>
+JitBaseBlockCache::GetCodeCRC(const std::vector<PhysicalRange>& physical_ranges) const
+{
+  auto& memory = m_jit.m_system.GetMemory();
+  const auto IsInRAM = [&memory](u32 start, u32 end) {
+    if (end <= memory.GetRamSizeReal())
+      return true;
+    constexpr u32 EXRAM_START = 0x10000000;
+    return start >= EXRAM_START && end - EXRAM_START <= memory.GetExRamSizeReal();
+  };
+
+  u32 crc = Common::StartCRC32();
+  for (const PhysicalRange& range : physical_ranges)
+  {
+    // Code in the locked L1 cache can't be checked, so it isn't profiled.
+    if (range.start >= range.end || !IsInRAM(range.start, range.end))
+      return std::nullopt;
+
+    const u32 size = range.end - range.start;
+    crc = Common::UpdateCRC32(crc, memory.GetPointerForRange(range.start, size), size);
+  }
+  return crc;
+}
+
+bool JitBaseBlockCache::IsProfiledBlockValid(const ProfiledBlock& block) const
+{
+  const auto translated = m_jit.m_mmu.JitCache_TranslateAddress(block.effective_address);
+  if (!translated.valid || translated.address != block.physical_address)
+    return false;
+
+  return GetCodeCRC(block.physical_ranges) == block.code_crc;
+}
+
 void JitBaseBlockCache::WriteDestroyBlock(const JitBlock& block)
 {
 }
@@ -444,7 +785,10 @@ void JitBaseBlockCache::LinkBlockExits(JitBlock& block)
     if (!e.linkStatus)
     {
       JitBlock* destinationBlock = GetBlockFromStartAddress(e.exitAddress, block.feature_flags);
-      if (destinationBlock)
+      // Exits which leave registers unstored can only jump straight to blocks that overwrite them.
+      if (destinationBlock &&
+          !(e.unstoredGPRs & ~destinationBlock->overwritten_gprs) &&
+          !(e.unstoredFPRs & ~destinationBlock->overwritten_fprs))
       {
         WriteLinkBlock(e, destinationBlock);
         e.linkStatus = true;
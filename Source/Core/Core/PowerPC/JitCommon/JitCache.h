@@ -10,11 +10,15 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/RangeSet.h"
 #include "Core/HW/Memmap.h"
@@ -97,9 +101,24 @@ struct JitBlock : public JitBlockData
     u32 exitAddress;
     bool linkStatus;  // is it already linked?
     bool call;
+    // Registers which the exit leaves unstored, relying on the destination block to overwrite
+    // them. The exit may only be linked to blocks which overwrite all of them, and when it isn't
+    // linked, it jumps to unlinkedTarget, which stores them before dispatching.
+    BitSet32 unstoredGPRs{};
+    BitSet32 unstoredFPRs{};
+    const u8* unlinkedTarget = nullptr;
   };
   std::vector<LinkData> linkData;
 
+  // Registers which this block overwrites before reading them. See
+  // PPCAnalyst::CodeBlock::m_gpr_overwritten.
+  BitSet32 overwritten_gprs;
+  BitSet32 overwritten_fprs;
+
+  // The number of register stores left out of this block's exits because the blocks they jump to
+  // overwrite those registers.
+  u32 skipped_exit_stores = 0;
+
   // This set stores all physical addresses of all occupied instructions.
   Common::RangeSet<u32> physical_addresses;
 
@@ -108,6 +127,15 @@ struct JitBlock : public JitBlockData
   std::vector<std::pair<u32, UGeckoInstruction>> original_buffer;
 
   std::unique_ptr<ProfileData> profile_data;
+
+  // Decremented by the block every time it runs, if it was compiled to count its runs, and the CPU
+  // cycle count when the countdown last started. See JitBase::REGION_COMPILATION_THRESHOLD.
+  u32 region_countdown = 0;
+  u64 region_countdown_start = 0;
+
+  // The value of the block cache's use clock when this block was last seen running (or was
+  // compiled). See JitBaseBlockCache::SampleBlockUse.
+  u64 last_used = 0;
 };
 
 typedef void (*CompiledCode)();
@@ -142,6 +170,15 @@ public:
   bool Test(u32 bit) const { return (m_valid_block[bit / 32] & (1u << (bit % 32))) != 0; }
 };
 
+struct JitCodeSpaceStats
+{
+  // How often the whole cache was cleared because the JIT ran out of code space.
+  u64 full_flushes = 0;
+  // How often cold blocks were evicted to make room instead, and how many blocks that evicted.
+  u64 partial_evictions = 0;
+  u64 evicted_blocks = 0;
+};
+
 class JitBaseBlockCache
 {
 public:
@@ -170,6 +207,18 @@ public:
   void FinalizeBlock(JitBlock& block, bool block_link, const PPCAnalyst::CodeBlock& code_block,
                      const PPCAnalyst::CodeBuffer& code_buffer);
 
+  const JitCodeSpaceStats& GetCodeSpaceStats() const { return m_code_space_stats; }
+
+  // Called by the JITs when they run out of code space. Destroys the least recently used half of
+  // the blocks so that their space can be reused. If there are too few blocks for this to help,
+  // nothing is destroyed and false is returned, and the caller should clear the whole cache.
+  bool EvictColdBlocks();
+
+  // Marks the block starting at em_address, if there is one, as recently used. This is called at
+  // the start of every timing slice, which samples running blocks roughly by how much time they
+  // take up.
+  void SampleBlockUse(u32 em_address, CPUEmuFeatureFlags feature_flags);
+
   // Look for the block in the slow but accurate way.
   // This function shall be used if FastLookupIndexForAddress() failed.
   // This might return nullptr if there is no such block.
@@ -185,9 +234,18 @@ public:
   void InvalidateICacheLine(u32 address);
   void ErasePhysicalRange(u32 address, u32 length);
   void EraseSingleBlock(const JitBlock& block);
+  // Removes a block returned by AllocateBlock which failed to compile and was never finalized.
+  void EraseFailedBlock(const JitBlock& block);
 
   u32* GetBlockBitSet() const;
 
+  // If em_address is the start of a block from the block profile of the last session (see
+  // Config::MAIN_JIT_BLOCK_PROFILE), starts compiling every block of that profile which matches the
+  // current contents of memory. Each call compiles a bounded number of blocks, and calls made while
+  // a pass is underway carry it on, until the pass is done or the code space runs low. The block
+  // at em_address itself is left to the caller.
+  void PrecompileProfiledBlocks(u32 em_address);
+
 protected:
   virtual void DestroyBlock(JitBlock& block);
 
@@ -207,6 +265,53 @@ private:
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address, u32 msr);
 
+  // A half-open range of physical addresses.
+  struct PhysicalRange
+  {
+    u32 start;
+    u32 end;
+  };
+
+  // A block that was compiled in a previous session, and the code it was compiled from.
+  struct ProfiledBlock
+  {
+    u32 effective_address;
+    u32 physical_address;
+    CPUEmuFeatureFlags feature_flags;
+    u32 code_crc;
+    u64 run_count;
+    std::vector<PhysicalRange> physical_ranges;
+    u32 failed_attempts = 0;
+  };
+
+  void LoadBlockProfile();
+  void SaveBlockProfile() const;
+  void RecordBlockProfile();
+  std::optional<u32> GetCodeCRC(const std::vector<PhysicalRange>& physical_ranges) const;
+  bool IsProfiledBlockValid(const ProfiledBlock& block) const;
+  void ClearPendingProfiledBlocks();
+
+  // Path of the block profile of the running game, or empty if block profiles are disabled.
+  std::string m_block_profile_path;
+  // Blocks compiled during this session, indexed by effective address and feature flags.
+  std::map<std::pair<u32, CPUEmuFeatureFlags>, ProfiledBlock> m_block_profile;
+  // Blocks of the last session that haven't been compiled yet, with the most used ones first.
+  std::vector<ProfiledBlock> m_pending_profiled_blocks;
+  // Addresses that start a precompile pass when no pass is underway.
+  std::unordered_set<u32> m_pending_profiled_addresses;
+  // Position of the precompile pass in m_pending_profiled_blocks.
+  std::size_t m_next_profiled_block = 0;
+  // Blocks of the current pass that didn't match memory, to be tried again in the next pass.
+  std::vector<ProfiledBlock> m_retried_profiled_blocks;
+  bool m_precompile_pass_active = false;
+
+  // Below this many blocks, EvictColdBlocks gives up in favor of clearing the whole cache.
+  static constexpr std::size_t MIN_BLOCKS_FOR_EVICTION = 0x100;
+
+  // Advanced by every call to SampleBlockUse.
+  u64 m_block_use_clock = 0;
+  JitCodeSpaceStats m_code_space_stats;
+
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
   std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
@@ -254,6 +254,13 @@ std::vector<JitBase::MemoryStats> JitInterface::GetMemoryStats() const
   return {};
 }
 
+JitCodeSpaceStats JitInterface::GetCodeSpaceStats() const
+{
+  if (m_jit)
+    return m_jit->GetBlockCache()->GetCodeSpaceStats();
+  return {};
+}
+
 std::size_t JitInterface::DisassembleNearCode(const JitBlock& block, std::ostream& stream) const
 {
   if (m_jit)
@@ -19,6 +19,7 @@ class CPUCoreBase;
 class PointerWrap;
 class JitBase;
 struct JitBlock;
+struct JitCodeSpaceStats;
 
 namespace Core
 {
@@ -77,6 +78,7 @@ public:
   // Memory region name, free size, and fragmentation ratio
   using MemoryStats = std::pair<std::string_view, std::pair<std::size_t, double>>;
   std::vector<MemoryStats> GetMemoryStats() const;
+  JitCodeSpaceStats GetCodeSpaceStats() const;
 
   // Disassemble the recompiled code from a JIT block. Returns the disassembled instruction count.
   std::size_t DisassembleNearCode(const JitBlock& block, std::ostream& stream) const;
@@ -40,6 +40,8 @@ namespace PPCAnalyst
 {
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
+// Used in region mode, where the extra code size is only spent on code that runs very often.
+constexpr u32 REGION_BRANCH_FOLLOWING_THRESHOLD = 8;
 
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
@@ -826,6 +828,8 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   u32 num_inst = 0;
 
   const bool enable_follow = m_enable_branch_following;
+  const u32 branch_following_threshold =
+      m_is_region_mode_enabled ? REGION_BRANCH_FOLLOWING_THRESHOLD : BRANCH_FOLLOWING_THRESHOLD;
 
   auto& system = Core::System::GetInstance();
   auto& mmu = system.GetMMU();
@@ -889,7 +893,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       {
         code[i].branchTo = code[caller].address + 4;
         if ((inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION) &&
-            numFollows < BRANCH_FOLLOWING_THRESHOLD)
+            numFollows < branch_following_threshold)
         {
           // bclrx with unconditional branch = return
           // Follow it if we can propagate the LR value of the last CALL instruction.
@@ -943,7 +947,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     code[i].branchIsIdleLoop =
         code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
 
-    if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
+    if (follow && numFollows < branch_following_threshold)
     {
       // Follow the unconditional branch.
       numFollows++;
@@ -1150,6 +1154,8 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   block->m_gqr_used = gqrUsed;
   block->m_gqr_modified = gqrModified;
   block->m_gpr_inputs = gprBlockInputs;
+  block->m_gpr_overwritten = gprDiscardable;
+  block->m_fpr_overwritten = fprDiscardable;
   return address;
 }
 
@@ -128,6 +128,12 @@ struct CodeBlock
   // Which GPRs this block reads from before defining, if any.
   BitSet32 m_gpr_inputs;
 
+  // Which registers this block overwrites before reading them, without any way of leaving the
+  // block in between. Their values on entry don't matter, so blocks linking here don't need to
+  // store them.
+  BitSet32 m_gpr_overwritten;
+  BitSet32 m_fpr_overwritten;
+
   // Which memory locations are occupied by this block.
   Common::RangeSet<u32> m_physical_addresses;
 };
@@ -181,6 +187,9 @@ public:
   void SetBranchFollowingEnabled(bool enabled) { m_enable_branch_following = enabled; }
   void SetFloatExceptionsEnabled(bool enabled) { m_enable_float_exceptions = enabled; }
   void SetDivByZeroExceptionsEnabled(bool enabled) { m_enable_div_by_zero_exceptions = enabled; }
+  // Region mode follows more branches, so that hot code spanning several blocks (like a loop body
+  // calling small functions) is compiled as one unit.
+  void SetRegionModeEnabled(bool enabled) { m_is_region_mode_enabled = enabled; }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size) const;
 
 private:
@@ -205,6 +214,7 @@ private:
   bool m_enable_branch_following = false;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
+  bool m_is_region_mode_enabled = false;
 };
 
 void FindFunctions(const Core::CPUThreadGuard& guard, u32 startAddr, u32 endAddr,
@@ -61,7 +61,7 @@ static void InvalidateCacheThreadSafe(Core::System& system, u64 userdata, s64 cy
 
 PowerPCManager::PowerPCManager(Core::System& system)
     : m_breakpoints(system), m_memchecks(system), m_debug_interface(system, m_symbol_db),
-      m_system(system)
+      m_sampling_profiler(system), m_system(system)
 {
 }
 
@@ -314,6 +314,7 @@ void PowerPCManager::ScheduleInvalidateCacheThreadSafe(u32 address)
 void PowerPCManager::Shutdown()
 {
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_registered_config_callback_id);
+  m_sampling_profiler.Stop();
   InjectExternalCPUCore(nullptr);
   m_system.GetJitInterface().Shutdown();
   m_system.GetInterpreter().Shutdown();
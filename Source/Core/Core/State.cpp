@@ -4,12 +4,21 @@
 #include "Core/State.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
 #include <filesystem>
+#include <future>
 #include <locale>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <random>
 #include <shared_mutex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -18,7 +27,10 @@
 
 #include <lz4.h>
 #include <lzo/lzo1x.h>
+#include <zdict.h>
+#include <zstd.h>
 
+#include "Common/Align.h"
 #include "Common/Buffer.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -27,6 +39,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/ScopeGuard.h"
 #include "Common/Thread.h"
 #include "Common/TimeUtil.h"
 #include "Common/TransferableSharedMutex.h"
@@ -34,10 +47,14 @@
 #include "Common/WorkQueueThread.h"
 
 #include "Core/AchievementManager.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/DSPEmulator.h"
 #include "Core/GeckoCode.h"
+#include "Core/HW/CPU.h"
+#include "Core/HW/DSP.h"
 #include "Core/HW/HW.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/Wiimote.h"
@@ -48,6 +65,8 @@
 
 #include "UICommon/UICommon.h"
 
+#include "VideoCommon/AsyncRequests.h"
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -73,8 +92,18 @@ static Common::EventHook s_flush_unsaved_data_hook;
 // Temporary undo state buffer
 static Common::UniqueBuffer<u8> s_undo_load_buffer;
 
-// Used to estimate buffer size for the next save.
-static u32 s_last_state_size = 0;
+// Used to estimate buffer size for the next save. Only a few parts of the state can change much in
+// size between saves, and those can estimate their current size. The rest is assumed to be as
+// large as in the previous save.
+struct StateSizeEstimate
+{
+  std::size_t last_state_size = 0;
+  std::size_t last_variable_size = 0;
+};
+static StateSizeEstimate s_state_size_estimate;
+
+// Size of each section of the last saved state, in the order of the markers ending them.
+static std::vector<std::pair<std::string, std::size_t>> s_last_state_sections;
 
 // Shared locks are acquired for each state save task.
 // Tasks generally transition from: Calling thread -> CPU thread -> Compress/Write thread.
@@ -87,6 +116,8 @@ struct CompressAndDumpStateArgs
 {
   Common::UniqueBuffer<u8> buffer;
   std::string filename;
+  CompressionType compression_type;
+  int compression_level;
   std::shared_lock<decltype(s_state_saves_in_progress)> task_lock;
 };
 
@@ -94,6 +125,64 @@ struct CompressAndDumpStateArgs
 // Only the CPU thread manipulates this worker.
 static Common::WorkQueueThreadSP<CompressAndDumpStateArgs> s_compress_and_dump_thread;
 
+// The rewind buffer keeps a chain of backward deltas: each entry holds what changed between a
+// snapshot and the one taken after it, LZ4-compressed. Only the newest snapshot is kept
+// uncompressed, so stepping back costs one decompression no matter how many entries the ring
+// holds.
+//
+// Emulated memory is left out of the snapshots (see MemoryManager::SetExternalStateContents).
+// Instead, a copy of it is updated from the pages written since the previous snapshot, and only
+// the pages that actually changed go into the delta.
+struct RewindDelta
+{
+  // XOR of the two snapshots without emulated memory.
+  Common::UniqueBuffer<u8> compressed_state;
+  // Size of the XOR-ed data, which covers the larger of the two snapshots.
+  std::size_t state_delta_size = 0;
+  // Size of the older snapshot.
+  std::size_t state_size = 0;
+  // Changed memory pages, as a u32 page index followed by the XOR of the page for each of them.
+  Common::UniqueBuffer<u8> compressed_memory;
+  std::size_t memory_delta_size = 0;
+};
+
+constexpr std::size_t REWIND_PAGE_SIZE = Memory::MemoryManager::STATE_PAGE_SIZE;
+constexpr std::size_t REWIND_PAGE_RECORD_SIZE = sizeof(u32) + REWIND_PAGE_SIZE;
+
+struct CompressRewindDeltaArgs
+{
+  Common::UniqueBuffer<u8> previous;
+  std::size_t previous_size;
+  std::span<const u8> current;
+  Common::UniqueBuffer<u8> memory_delta;
+  std::size_t memory_delta_size;
+  std::size_t memory_budget;
+};
+
+// Newest snapshot. Only the CPU thread modifies these. The rewind worker reads the snapshot while
+// it computes a delta against it, so wait for the worker before touching it.
+static Common::UniqueBuffer<u8> s_rewind_reference;
+static std::size_t s_rewind_reference_size = 0;
+// Emulated memory as of the newest snapshot, as a sequence of state pages.
+static Common::UniqueBuffer<u8> s_rewind_memory;
+static std::vector<bool> s_rewind_dirty_pages;
+static u32 s_rewind_frames_since_reference = 0;
+
+// Protects the data below, which is shared with the rewind worker.
+static std::mutex s_rewind_mutex;
+static std::deque<RewindDelta> s_rewind_deltas;
+static std::size_t s_rewind_memory_usage = 0;
+// Recycled so that taking a snapshot doesn't need to allocate every time.
+static Common::UniqueBuffer<u8> s_rewind_spare_buffer;
+static Common::UniqueBuffer<u8> s_rewind_spare_memory_delta;
+
+// Scratch space for LZ4 output. Only used by the rewind worker.
+static Common::UniqueBuffer<u8> s_rewind_compress_buffer;
+
+// Queue for computing and compressing rewind deltas.
+// Only the CPU thread manipulates this worker.
+static Common::WorkQueueThreadSP<CompressRewindDeltaArgs> s_rewind_thread;
+
 // Don't forget to increase this after doing changes on the savestate system
 constexpr u32 STATE_VERSION = 181;  // Last changed in PR 14400
 
@@ -103,6 +192,10 @@ constexpr u32 EXTENDED_HEADER_VERSION = 1;  // Last changed in PR 12217
 // Change this if we ever need to store more data in the extended header
 constexpr u32 COMPRESSED_DATA_OFFSET = 0;
 
+// Size of the independently compressed chunks of a state. Small enough for a Wii state to keep
+// every thread busy, large enough to not hurt the compression ratio.
+constexpr u32 STATE_CHUNK_SIZE = 0x100000;
+
 constexpr u32 COOKIE_BASE = 0xBAADBABE;
 
 // Maps savestate versions to Dolphin versions.
@@ -227,28 +320,53 @@ static bool LoadFromBuffer(Core::System& system, std::span<u8> buffer)
   return p.IsReadMode();
 }
 
+static std::size_t EstimateVariableStateSize(Core::System& system)
+{
+  return system.GetMemory().EstimateStateSize() + system.GetDSP().EstimateStateSize() +
+         g_video_backend->EstimateStateSize();
+}
+
 // Returns the required size, or 0 on failure.
 static std::size_t SaveToBuffer(Core::System& system, Common::UniqueBuffer<u8>& buffer)
 {
-  // Attempt to save to our provided buffer as-is.
+  // Make sure the buffer is a bit larger than the expected size of the state.
+  // This will usually avoid having to serialize everything a second time after measuring it.
+  const std::size_t variable_size = EstimateVariableStateSize(system);
+  const std::size_t expected_size =
+      std::max(s_state_size_estimate.last_state_size, s_state_size_estimate.last_variable_size) -
+      s_state_size_estimate.last_variable_size + variable_size;
+  if (buffer.size() < expected_size * 110 / 100)
+    buffer.reset(expected_size * 110 / 100);
+
   // If buffer isn't large enough, PointerWrap transitions to MeasureMode,
   //  and then we have our measurement for a second attempt.
   u8* ptr = buffer.data();
   PointerWrap pointer_wrap(&ptr, buffer.size(), PointerWrap::Mode::Write);
+
+  std::vector<std::pair<std::string, std::size_t>> sections;
+  const u8* section_start = buffer.data();
+  pointer_wrap.SetMarkerCallback([&](const std::string& name, const u8* position) {
+    sections.emplace_back(name, static_cast<std::size_t>(position - section_start));
+    section_start = position;
+  });
+
   DoState(system, pointer_wrap);
   const auto measured_size = pointer_wrap.GetOffsetFromPreviousPosition(buffer.data());
 
-  if (pointer_wrap.IsWriteMode())
+  if (pointer_wrap.IsWriteMode() || measured_size > buffer.size())
   {
-    s_last_state_size = measured_size;
-    return measured_size;
+    s_state_size_estimate = {measured_size, variable_size};
+    s_last_state_sections = std::move(sections);
   }
 
+  if (pointer_wrap.IsWriteMode())
+    return measured_size;
+
   if (measured_size > buffer.size())
   {
-    DEBUG_LOG_FMT(CORE, "SaveToBuffer: Growing buffer from size {} to measured size {}",
+    DEBUG_LOG_FMT(CORE, "SaveToBuffer: Growing buffer from size {} for measured size {}",
                   buffer.size(), measured_size);
-    buffer.reset(measured_size);
+    buffer.reset(measured_size * 110 / 100);
     return SaveToBuffer(system, buffer);
   }
 
@@ -322,50 +440,125 @@ static std::vector<SlotWithTimestamp> GetUsedSlotsWithTimestamp()
   return result;
 }
 
-static void CompressBufferToFile(std::span<const u8> raw_buffer, File::IOFile& f)
+static u32 GetStateChunkThreadCount(u32 chunk_count)
 {
-  u64 total_bytes_compressed = 0;
+  return std::min(chunk_count, std::max(1u, std::thread::hardware_concurrency()));
+}
 
-  while (true)
+static std::size_t GetMaxCompressedChunkSize(CompressionType compression_type,
+                                             std::size_t chunk_size)
+{
+  if (compression_type == CompressionType::ChunkedZstd)
+    return ZSTD_compressBound(chunk_size);
+  return LZ4_compressBound(static_cast<int>(chunk_size));
+}
+
+using ZstdCompressionContext = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
+using ZstdDecompressionContext = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
+using ZstdCompressionDictionary = std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)>;
+using ZstdDecompressionDictionary = std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)>;
+
+// Returns the compressed size, or 0 on failure.
+static std::size_t CompressStateChunk(CompressionType compression_type, int compression_level,
+                                      ZSTD_CCtx* zstd_context, const ZSTD_CDict* zstd_dictionary,
+                                      std::span<const u8> chunk,
+                                      Common::UniqueBuffer<char>& compressed_chunk)
+{
+  compressed_chunk.reset(GetMaxCompressedChunkSize(compression_type, chunk.size()));
+
+  if (compression_type == CompressionType::ChunkedZstd)
   {
-    const u64 bytes_left_to_compress = raw_buffer.size() - total_bytes_compressed;
+    if (!zstd_context)
+      return 0;
+
+    const std::size_t result =
+        zstd_dictionary ?
+            ZSTD_compress_usingCDict(zstd_context, compressed_chunk.get(), compressed_chunk.size(),
+                                     chunk.data(), chunk.size(), zstd_dictionary) :
+            ZSTD_compressCCtx(zstd_context, compressed_chunk.get(), compressed_chunk.size(),
+                              chunk.data(), chunk.size(), compression_level);
+    return ZSTD_isError(result) ? 0 : result;
+  }
+
+  const int result = LZ4_compress_default(
+      reinterpret_cast<const char*>(chunk.data()), compressed_chunk.get(),
+      static_cast<int>(chunk.size()), static_cast<int>(compressed_chunk.size()));
+  return std::max(result, 0);
+}
 
-    const int bytes_to_compress =
-        static_cast<int>(std::min(static_cast<u64>(LZ4_MAX_INPUT_SIZE), bytes_left_to_compress));
-    Common::UniqueBuffer<char> compressed_buffer(LZ4_compressBound(bytes_to_compress));
-    const int compressed_len = LZ4_compress_default(
-        reinterpret_cast<const char*>(raw_buffer.data()) + total_bytes_compressed,
-        compressed_buffer.get(), bytes_to_compress, int(compressed_buffer.size()));
+static bool CompressBufferToFile(std::span<const u8> raw_buffer, CompressionType compression_type,
+                                 int compression_level, std::span<const u8> dictionary,
+                                 File::IOFile& f)
+{
+  const u32 chunk_count =
+      static_cast<u32>(Common::AlignUp(raw_buffer.size(), STATE_CHUNK_SIZE) / STATE_CHUNK_SIZE);
 
-    if (compressed_len == 0)
+  // Digesting the dictionary is expensive, so it's done once and shared by all threads.
+  ZstdCompressionDictionary zstd_dictionary(nullptr, ZSTD_freeCDict);
+  if (compression_type == CompressionType::ChunkedZstd && !dictionary.empty())
+  {
+    zstd_dictionary.reset(
+        ZSTD_createCDict(dictionary.data(), dictionary.size(), compression_level));
+    if (!zstd_dictionary)
     {
-      PanicAlertFmtT("Internal LZ4 Error - compression failed");
-      break;
+      PanicAlertFmt("Unable to load the zstd dictionary for the state");
+      return false;
     }
+  }
 
-    // The size of the data to write is 'compressed_len'
-    f.WriteArray(&compressed_len, 1);
-    f.WriteBytes(compressed_buffer.get(), compressed_len);
+  std::vector<Common::UniqueBuffer<char>> compressed_chunks(chunk_count);
+  std::vector<u32> compressed_sizes(chunk_count);
+  std::atomic<bool> success = true;
 
-    total_bytes_compressed += bytes_to_compress;
-    if (total_bytes_compressed == raw_buffer.size())
-      break;
+  const u32 thread_count = GetStateChunkThreadCount(chunk_count);
+  std::vector<std::future<void>> futures(thread_count);
+  for (u32 i = 0; i < thread_count; ++i)
+  {
+    futures[i] = std::async(std::launch::async, [&, i] {
+      ZstdCompressionContext zstd_context(nullptr, ZSTD_freeCCtx);
+      if (compression_type == CompressionType::ChunkedZstd)
+        zstd_context.reset(ZSTD_createCCtx());
+
+      for (u32 chunk = i; chunk < chunk_count && success; chunk += thread_count)
+      {
+        const std::size_t offset = std::size_t(chunk) * STATE_CHUNK_SIZE;
+        const std::size_t size =
+            std::min<std::size_t>(STATE_CHUNK_SIZE, raw_buffer.size() - offset);
+
+        const std::size_t compressed_size =
+            CompressStateChunk(compression_type, compression_level, zstd_context.get(),
+                               zstd_dictionary.get(), raw_buffer.subspan(offset, size),
+                               compressed_chunks[chunk]);
+        if (compressed_size == 0)
+          success = false;
+        compressed_sizes[chunk] = static_cast<u32>(compressed_size);
+      }
+    });
   }
-}
 
-static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size)
-{
-  StateExtendedBaseHeader& base_header = extended_header.base_header;
-  base_header.header_version = EXTENDED_HEADER_VERSION;
-  base_header.compression_type =
-      s_use_compression ? CompressionType::LZ4 : CompressionType::Uncompressed;
-  base_header.payload_offset = COMPRESSED_DATA_OFFSET;
-  base_header.uncompressed_size = uncompressed_size;
+  for (std::future<void>& future : futures)
+    future.get();
 
-  // If more fields are added to StateExtendedHeader, set them here.
+  if (!success)
+  {
+    if (compression_type == CompressionType::ChunkedZstd)
+      PanicAlertFmt("Internal zstd Error - compression failed");
+    else
+      PanicAlertFmtT("Internal LZ4 Error - compression failed");
+    return false;
+  }
+
+  const StateChunkTableHeader table_header{.chunk_size = STATE_CHUNK_SIZE,
+                                           .chunk_count = chunk_count};
+  f.WriteArray(&table_header, 1);
+  f.WriteArray(compressed_sizes.data(), compressed_sizes.size());
+  for (u32 chunk = 0; chunk < chunk_count; ++chunk)
+    f.WriteBytes(compressed_chunks[chunk].get(), compressed_sizes[chunk]);
+
+  return true;
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+static StateHeader CreateStateHeader()
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
@@ -376,8 +569,26 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   header.version_string = Common::GetScmRevStr();
   header.version_header.version_string_length = static_cast<u32>(header.version_string.length());
 
+  return header;
+}
+
+static void CreateExtendedHeader(StateExtendedHeader& extended_header,
+                                 CompressionType compression_type, size_t uncompressed_size)
+{
+  StateExtendedBaseHeader& base_header = extended_header.base_header;
+  base_header.header_version = EXTENDED_HEADER_VERSION;
+  base_header.compression_type = compression_type;
+  base_header.payload_offset = COMPRESSED_DATA_OFFSET;
+  base_header.uncompressed_size = uncompressed_size;
+
+  // If more fields are added to StateExtendedHeader, set them here.
+}
+
+static void WriteHeadersToFile(const StateHeader& header, CompressionType compression_type,
+                               size_t uncompressed_size, File::IOFile& f)
+{
   StateExtendedHeader extended_header{};
-  CreateExtendedHeader(extended_header, uncompressed_size);
+  CreateExtendedHeader(extended_header, compression_type, uncompressed_size);
 
   f.WriteArray(&header.legacy_header, 1);
   f.WriteArray(&header.version_header, 1);
@@ -387,6 +598,54 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   // If StateExtendedHeader is amended to include more than the base, add WriteBytes() calls here.
 }
 
+static bool WriteStateToFile(const StateHeader& header, std::span<const u8> buffer,
+                             CompressionType compression_type, int compression_level,
+                             std::span<const u8> dictionary, File::IOFile& f)
+{
+  WriteHeadersToFile(header, compression_type, buffer.size(), f);
+
+  if (compression_type == CompressionType::Uncompressed)
+    return f.WriteBytes(buffer.data(), buffer.size());
+
+  return CompressBufferToFile(buffer, compression_type, compression_level, dictionary, f);
+}
+
+std::string GetCompressionDictionaryPath(std::string_view game_id)
+{
+  return fmt::format("{}{}.zdict", File::GetUserPath(D_STATESAVES_IDX), game_id);
+}
+
+static std::vector<u8> LoadCompressionDictionary(std::string_view game_id)
+{
+  const std::string path = GetCompressionDictionaryPath(game_id);
+  if (!File::Exists(path))
+    return {};
+
+  File::IOFile f(path, "rb");
+  std::vector<u8> dictionary(f.GetSize());
+  if (!f.ReadBytes(dictionary.data(), dictionary.size()))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to read state compression dictionary {}", path);
+    return {};
+  }
+  return dictionary;
+}
+
+static std::pair<CompressionType, int> GetConfiguredCompression()
+{
+  if (!s_use_compression)
+    return {CompressionType::Uncompressed, 0};
+
+  if (Config::Get(Config::MAIN_SAVESTATE_COMPRESSION) == "Zstd")
+  {
+    const int level = std::clamp(Config::Get(Config::MAIN_SAVESTATE_COMPRESSION_LEVEL),
+                                 ZSTD_minCLevel(), ZSTD_maxCLevel());
+    return {CompressionType::ChunkedZstd, level};
+  }
+
+  return {CompressionType::ChunkedLZ4, 0};
+}
+
 static void CompressAndDumpState(Core::System& system, const CompressAndDumpStateArgs& save_args)
 {
   const auto& buffer = save_args.buffer;
@@ -411,12 +670,18 @@ static void CompressAndDumpState(Core::System& system, const CompressAndDumpStat
     return;
   }
 
-  WriteHeadersToFile(buffer.size(), f);
+  const StateHeader header = CreateStateHeader();
+  std::vector<u8> dictionary;
+  if (save_args.compression_type == CompressionType::ChunkedZstd)
+    dictionary = LoadCompressionDictionary(SConfig::GetInstance().GetGameID());
 
-  if (s_use_compression)
-    CompressBufferToFile(buffer, f);
-  else
-    f.WriteBytes(buffer.data(), buffer.size());
+  if (!WriteStateToFile(header, buffer, save_args.compression_type, save_args.compression_level,
+                        dictionary, f))
+  {
+    f.Close();
+    File::Delete(temp_filename);
+    return;
+  }
 
   if (!f.IsGood())
     Core::DisplayMessage("Failed to write state file", 2000);
@@ -469,19 +734,27 @@ static void CompressAndDumpState(Core::System& system, const CompressAndDumpStat
 
 static void SaveAsFromCore(Core::System& system, std::string filename)
 {
-  // Try with a buffer a bit larger than the previous state.
-  // This will often avoid the "Measure" step.
-  const auto buffer_size_estimate = std::size_t(s_last_state_size) * 110 / 100;
-  Common::UniqueBuffer<u8> buffer{buffer_size_estimate};
+  Common::UniqueBuffer<u8> buffer;
 
   if (const auto actual_size = SaveToBuffer(system, buffer))
   {
+    const auto largest_section = std::ranges::max_element(
+        s_last_state_sections, {}, &std::pair<std::string, std::size_t>::second);
+    if (largest_section != s_last_state_sections.end())
+    {
+      INFO_LOG_FMT(CORE, "State size: {} bytes, largest part: {} ({} bytes)", actual_size,
+                   largest_section->first, largest_section->second);
+    }
+
     // Adjust the oversized buffer down to the actual size.
     buffer.assign(buffer.extract().first, actual_size);
 
+    const auto [compression_type, compression_level] = GetConfiguredCompression();
     CompressAndDumpStateArgs dump_args{
         .buffer = std::move(buffer),
         .filename = std::move(filename),
+        .compression_type = compression_type,
+        .compression_level = compression_level,
         .task_lock = GetStateSaveTaskLock(),
     };
     Core::DisplayMessage("Saving State...", 1000);
@@ -690,6 +963,171 @@ static bool DecompressLZ4(Common::UniqueBuffer<u8>& raw_buffer, u64 size, File::
   }
 }
 
+static bool DecompressChunks(Common::UniqueBuffer<u8>& raw_buffer, u64 size,
+                             CompressionType compression_type, std::span<const u8> dictionary,
+                             File::IOFile& f)
+{
+  StateChunkTableHeader table_header;
+  if (!f.ReadArray(&table_header, 1))
+  {
+    PanicAlertFmt("Could not read state chunk table");
+    return false;
+  }
+
+  const u32 chunk_size = table_header.chunk_size;
+  const u32 chunk_count = table_header.chunk_count;
+  if (chunk_size == 0 || chunk_size > LZ4_MAX_INPUT_SIZE ||
+      Common::AlignUp(size, chunk_size) / chunk_size != chunk_count)
+  {
+    PanicAlertFmt("State chunk table corrupted");
+    return false;
+  }
+
+  std::vector<u32> compressed_sizes(chunk_count);
+  if (!f.ReadArray(compressed_sizes.data(), compressed_sizes.size()))
+  {
+    PanicAlertFmt("Could not read state chunk table");
+    return false;
+  }
+
+  const std::size_t max_compressed_size = GetMaxCompressedChunkSize(compression_type, chunk_size);
+  std::vector<u64> compressed_offsets(chunk_count + 1);
+  for (u32 chunk = 0; chunk < chunk_count; ++chunk)
+  {
+    if (compressed_sizes[chunk] == 0 || compressed_sizes[chunk] > max_compressed_size)
+    {
+      PanicAlertFmt("State chunk table corrupted");
+      return false;
+    }
+    compressed_offsets[chunk + 1] = compressed_offsets[chunk] + compressed_sizes[chunk];
+  }
+
+  if (compressed_offsets.back() > f.GetSize() - f.Tell())
+  {
+    PanicAlertFmt("Could not read state data");
+    return false;
+  }
+
+  ZstdDecompressionDictionary zstd_dictionary(nullptr, ZSTD_freeDDict);
+  if (compression_type == CompressionType::ChunkedZstd && !dictionary.empty())
+  {
+    zstd_dictionary.reset(ZSTD_createDDict(dictionary.data(), dictionary.size()));
+    if (!zstd_dictionary)
+    {
+      PanicAlertFmt("Unable to load the zstd dictionary for the state");
+      return false;
+    }
+  }
+
+  Common::UniqueBuffer<char> compressed_data(compressed_offsets.back());
+  raw_buffer.reset(size);
+
+  // Chunks are decompressed by the worker threads while later chunks are still being read.
+  std::atomic<u32> chunks_read = 0;
+  std::atomic<bool> read_failed = false;
+  std::atomic<bool> decompression_failed = false;
+  std::atomic<bool> dictionary_mismatch = false;
+
+  const u32 thread_count = GetStateChunkThreadCount(chunk_count);
+  std::vector<std::future<void>> futures(thread_count);
+  for (u32 i = 0; i < thread_count; ++i)
+  {
+    futures[i] = std::async(std::launch::async, [&, i] {
+      ZstdDecompressionContext zstd_context(nullptr, ZSTD_freeDCtx);
+      if (compression_type == CompressionType::ChunkedZstd)
+        zstd_context.reset(ZSTD_createDCtx());
+
+      for (u32 chunk = i; chunk < chunk_count; chunk += thread_count)
+      {
+        for (u32 read = chunks_read; read <= chunk; read = chunks_read)
+          chunks_read.wait(read);
+
+        if (read_failed || decompression_failed)
+          return;
+
+        const char* const compressed_chunk = compressed_data.get() + compressed_offsets[chunk];
+        const u64 offset = u64(chunk) * chunk_size;
+        u8* const chunk_data = raw_buffer.data() + offset;
+        const std::size_t expected_size = std::min<u64>(chunk_size, size - offset);
+
+        if (compression_type == CompressionType::ChunkedZstd)
+        {
+          // Chunks that were compressed without a dictionary have a dictionary ID of 0.
+          const unsigned dictionary_id =
+              ZSTD_getDictID_fromFrame(compressed_chunk, compressed_sizes[chunk]);
+          const ZSTD_DDict* chunk_dictionary = dictionary_id != 0 ? zstd_dictionary.get() : nullptr;
+          if (dictionary_id != ZSTD_getDictID_fromDDict(chunk_dictionary))
+          {
+            dictionary_mismatch = true;
+            decompression_failed = true;
+            return;
+          }
+
+          std::size_t result = 0;
+          if (zstd_context)
+          {
+            result = ZSTD_decompress_usingDDict(zstd_context.get(), chunk_data, expected_size,
+                                                compressed_chunk, compressed_sizes[chunk],
+                                                chunk_dictionary);
+          }
+          if (result != expected_size)
+            decompression_failed = true;
+        }
+        else
+        {
+          const int result = LZ4_decompress_safe(
+              compressed_chunk, reinterpret_cast<char*>(chunk_data),
+              static_cast<int>(compressed_sizes[chunk]), static_cast<int>(expected_size));
+          if (result != static_cast<int>(expected_size))
+            decompression_failed = true;
+        }
+      }
+    });
+  }
+
+  for (u32 chunk = 0; chunk < chunk_count && !decompression_failed; ++chunk)
+  {
+    if (!f.ReadBytes(compressed_data.get() + compressed_offsets[chunk], compressed_sizes[chunk]))
+    {
+      read_failed = true;
+      break;
+    }
+
+    chunks_read = chunk + 1;
+    chunks_read.notify_all();
+  }
+
+  // Wake up the workers that are waiting for chunks which won't be read anymore.
+  chunks_read = chunk_count;
+  chunks_read.notify_all();
+
+  for (std::future<void>& future : futures)
+    future.get();
+
+  if (read_failed)
+  {
+    PanicAlertFmt("Could not read state data");
+    return false;
+  }
+
+  if (dictionary_mismatch)
+  {
+    PanicAlertFmt("The state was compressed with a zstd dictionary that is not available");
+    return false;
+  }
+
+  if (decompression_failed)
+  {
+    if (compression_type == CompressionType::ChunkedZstd)
+      PanicAlertFmt("Internal zstd Error - decompression failed");
+    else
+      PanicAlertFmtT("Internal LZ4 Error - decompression failed");
+    return false;
+  }
+
+  return true;
+}
+
 static bool ValidateHeaders(const StateHeader& header)
 {
   bool success = true;
@@ -737,41 +1175,38 @@ static bool ValidateHeaders(const StateHeader& header)
   return success;
 }
 
-static void LoadFileStateData(const std::string& filename, Common::UniqueBuffer<u8>& ret_data)
+static bool ReadExtendedHeaderFromFile(StateExtendedHeader& extended_header, File::IOFile& f)
 {
-  File::IOFile f;
-  f.Open(filename, "rb");
-
-  StateHeader header;
-  if (!ReadStateHeaderFromFile(header, f) || !ValidateHeaders(header))
-    return;
-
-  StateExtendedHeader extended_header;
   if (!f.ReadArray(&extended_header.base_header, 1))
   {
     PanicAlertFmt("Unable to read state header");
-    return;
+    return false;
   }
   // If StateExtendedHeader is amended to include more than the base, add ReadBytes() calls here.
 
   if (extended_header.base_header.header_version != EXTENDED_HEADER_VERSION)
   {
     PanicAlertFmt("State header corrupted");
-    return;
+    return false;
   }
 
-  Common::UniqueBuffer<u8> buffer;
+  return true;
+}
 
-  switch (extended_header.base_header.compression_type)
+static bool ReadStatePayloadFromFile(const StateHeader& header,
+                                     const StateExtendedHeader& extended_header,
+                                     std::span<const u8> dictionary,
+                                     Common::UniqueBuffer<u8>& buffer, File::IOFile& f)
+{
+  const u16 compression_type = extended_header.base_header.compression_type;
+  switch (compression_type)
   {
   case CompressionType::LZ4:
-  {
-    Core::DisplayMessage("Decompressing State...", OSD::Duration::SHORT);
-    if (!DecompressLZ4(buffer, extended_header.base_header.uncompressed_size, f))
-      return;
-
-    break;
-  }
+    return DecompressLZ4(buffer, extended_header.base_header.uncompressed_size, f);
+  case CompressionType::ChunkedLZ4:
+  case CompressionType::ChunkedZstd:
+    return DecompressChunks(buffer, extended_header.base_header.uncompressed_size,
+                            static_cast<CompressionType>(compression_type), dictionary, f);
   case CompressionType::Uncompressed:
   {
     u64 header_len = sizeof(StateHeaderLegacy) + sizeof(StateHeaderVersion) +
@@ -782,7 +1217,7 @@ static void LoadFileStateData(const std::string& filename, Common::UniqueBuffer<
     if (file_size < header_len)
     {
       PanicAlertFmt("State header length corrupted");
-      return;
+      return false;
     }
 
     const auto size = static_cast<size_t>(file_size - header_len);
@@ -791,19 +1226,146 @@ static void LoadFileStateData(const std::string& filename, Common::UniqueBuffer<
     if (!f.ReadBytes(buffer.data(), size))
     {
       PanicAlertFmt("Error reading bytes: {0}", size);
-      return;
+      return false;
     }
-    break;
+    return true;
   }
   default:
-    PanicAlertFmt("Unknown compression type {0}", extended_header.base_header.compression_type);
-    return;
+    PanicAlertFmt("Unknown compression type {0}", compression_type);
+    return false;
   }
+}
+
+static void LoadFileStateData(const std::string& filename, Common::UniqueBuffer<u8>& ret_data)
+{
+  File::IOFile f;
+  f.Open(filename, "rb");
+
+  StateHeader header;
+  if (!ReadStateHeaderFromFile(header, f) || !ValidateHeaders(header))
+    return;
+
+  StateExtendedHeader extended_header;
+  if (!ReadExtendedHeaderFromFile(extended_header, f))
+    return;
+
+  const u16 compression_type = extended_header.base_header.compression_type;
+  if (compression_type != CompressionType::Uncompressed)
+    Core::DisplayMessage("Decompressing State...", OSD::Duration::SHORT);
+
+  std::vector<u8> dictionary;
+  if (compression_type == CompressionType::ChunkedZstd)
+    dictionary = LoadCompressionDictionary(SConfig::GetInstance().GetGameID());
+
+  Common::UniqueBuffer<u8> buffer;
+  if (!ReadStatePayloadFromFile(header, extended_header, dictionary, buffer, f))
+    return;
 
   // all good
   ret_data.swap(buffer);
 }
 
+static bool ReadStateFile(const std::string& path, std::span<const u8> dictionary,
+                          StateHeader& header, Common::UniqueBuffer<u8>& buffer)
+{
+  File::IOFile f(path, "rb");
+  if (!f)
+  {
+    PanicAlertFmt("Unable to open state {}", path);
+    return false;
+  }
+
+  if (!ReadStateHeaderFromFile(header, f))
+    return false;
+
+  // States this old can't be loaded by any version of Dolphin that writes extended headers.
+  if (header.legacy_header.lzo_size != 0)
+  {
+    PanicAlertFmt("State {} uses the obsolete LZO compression", path);
+    return false;
+  }
+
+  StateExtendedHeader extended_header;
+  return ReadExtendedHeaderFromFile(extended_header, f) &&
+         ReadStatePayloadFromFile(header, extended_header, dictionary, buffer, f);
+}
+
+bool RecompressStateFile(const std::string& path, const std::string& output_path,
+                         CompressionType compression_type, int compression_level,
+                         std::span<const u8> read_dictionary, std::span<const u8> write_dictionary)
+{
+  StateHeader header;
+  Common::UniqueBuffer<u8> buffer;
+  if (!ReadStateFile(path, read_dictionary, header, buffer))
+    return false;
+
+  File::IOFile f(output_path, "wb");
+  const bool success = f &&
+                       WriteStateToFile(header, buffer, compression_type, compression_level,
+                                        write_dictionary, f) &&
+                       f.IsGood();
+  if (!f.Close() || !success)
+  {
+    File::Delete(output_path);
+    return false;
+  }
+  return true;
+}
+
+std::vector<u8> TrainCompressionDictionary(std::span<const std::string> paths,
+                                           std::size_t dictionary_size,
+                                           std::span<const u8> read_dictionary)
+{
+  // The dictionary builder works best with samples of this size, and with about 100 times as
+  // much sample data as the size of the dictionary. To keep the memory usage bounded no matter
+  // how many states there are, a random selection of samples is kept.
+  constexpr std::size_t SAMPLE_SIZE = 0x20000;
+  const std::size_t max_sample_count =
+      std::max<std::size_t>(dictionary_size * 100 / SAMPLE_SIZE, 1);
+
+  std::vector<u8> samples;
+  std::size_t samples_seen = 0;
+  std::mt19937 random_engine;
+
+  for (const std::string& path : paths)
+  {
+    StateHeader header;
+    Common::UniqueBuffer<u8> buffer;
+    if (!ReadStateFile(path, read_dictionary, header, buffer))
+      return {};
+
+    for (std::size_t offset = 0; offset + SAMPLE_SIZE <= buffer.size(); offset += SAMPLE_SIZE)
+    {
+      std::size_t index = samples_seen++;
+      if (index >= max_sample_count)
+      {
+        index = std::uniform_int_distribution<std::size_t>(0, index)(random_engine);
+        if (index >= max_sample_count)
+          continue;
+      }
+
+      if (index == samples.size() / SAMPLE_SIZE)
+        samples.resize(samples.size() + SAMPLE_SIZE);
+      std::memcpy(samples.data() + index * SAMPLE_SIZE, buffer.data() + offset, SAMPLE_SIZE);
+    }
+  }
+
+  const std::size_t sample_count = samples.size() / SAMPLE_SIZE;
+  const std::vector<std::size_t> sample_sizes(sample_count, SAMPLE_SIZE);
+  std::vector<u8> dictionary(dictionary_size);
+  const std::size_t result =
+      ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.data(),
+                            sample_sizes.data(), static_cast<unsigned>(sample_count));
+  if (ZDICT_isError(result))
+  {
+    PanicAlertFmt("Unable to train a zstd dictionary: {}", ZDICT_getErrorName(result));
+    return {};
+  }
+
+  dictionary.resize(result);
+  return dictionary;
+}
+
 static void LoadAsFromCore(Core::System& system, std::string filename)
 {
   // Ensure all data has reached the filesystem before trying to use it.
@@ -881,10 +1443,386 @@ void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback)
   s_on_after_load_callback = std::move(callback);
 }
 
+// XORs src into the start of dst.
+static void XorIntoBuffer(u8* dst, std::span<const u8> src)
+{
+  std::size_t i = 0;
+  for (; i + sizeof(u64) <= src.size(); i += sizeof(u64))
+  {
+    u64 a, b;
+    std::memcpy(&a, dst + i, sizeof(u64));
+    std::memcpy(&b, src.data() + i, sizeof(u64));
+    a ^= b;
+    std::memcpy(dst + i, &a, sizeof(u64));
+  }
+  for (; i < src.size(); ++i)
+    dst[i] ^= src[i];
+}
+
+// Makes the first `size` bytes of the buffer usable as a delta: the first `used_size` bytes are
+// kept and the rest is zeroed, as if the smaller snapshot were padded with zeroes.
+static void PrepareDeltaBuffer(Common::UniqueBuffer<u8>& buffer, std::size_t used_size,
+                               std::size_t size)
+{
+  if (buffer.size() < size)
+  {
+    Common::UniqueBuffer<u8> grown_buffer(size);
+    std::copy_n(buffer.data(), used_size, grown_buffer.data());
+    buffer = std::move(grown_buffer);
+  }
+  if (used_size < size)
+    std::fill(buffer.data() + used_size, buffer.data() + size, 0);
+}
+
+// Returns an empty buffer on failure or if there is no data.
+static Common::UniqueBuffer<u8> CompressRewindData(const u8* data, std::size_t size)
+{
+  if (size == 0)
+    return {};
+
+  if (size > LZ4_MAX_INPUT_SIZE)
+  {
+    ERROR_LOG_FMT(CORE, "Rewind data of size {} is too large to compress", size);
+    return {};
+  }
+
+  const int bound = LZ4_compressBound(static_cast<int>(size));
+  if (s_rewind_compress_buffer.size() < static_cast<std::size_t>(bound))
+    s_rewind_compress_buffer.reset(bound);
+
+  const int compressed_size =
+      LZ4_compress_default(reinterpret_cast<const char*>(data),
+                           reinterpret_cast<char*>(s_rewind_compress_buffer.data()),
+                           static_cast<int>(size), bound);
+  if (compressed_size <= 0)
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress rewind data of size {}", size);
+    return {};
+  }
+
+  Common::UniqueBuffer<u8> compressed(compressed_size);
+  std::copy_n(s_rewind_compress_buffer.data(), compressed_size, compressed.data());
+  return compressed;
+}
+
+static bool DecompressRewindData(const Common::UniqueBuffer<u8>& compressed, std::size_t size,
+                                 Common::UniqueBuffer<u8>& buffer)
+{
+  if (size == 0)
+    return true;
+
+  if (buffer.size() < size)
+    buffer.reset(size);
+
+  const int decompressed_size =
+      LZ4_decompress_safe(reinterpret_cast<const char*>(compressed.data()),
+                          reinterpret_cast<char*>(buffer.data()),
+                          static_cast<int>(compressed.size()), static_cast<int>(size));
+  if (decompressed_size != static_cast<int>(size))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to decompress rewind data: expected {} bytes, got {}", size,
+                  decompressed_size);
+    return false;
+  }
+
+  return true;
+}
+
+static void CompressRewindDelta(CompressRewindDeltaArgs args)
+{
+  RewindDelta delta;
+  delta.state_delta_size = std::max(args.previous_size, args.current.size());
+  delta.state_size = args.previous_size;
+  delta.memory_delta_size = args.memory_delta_size;
+
+  PrepareDeltaBuffer(args.previous, args.previous_size, delta.state_delta_size);
+  XorIntoBuffer(args.previous.data(), args.current);
+
+  delta.compressed_state = CompressRewindData(args.previous.data(), delta.state_delta_size);
+  delta.compressed_memory = CompressRewindData(args.memory_delta.data(), args.memory_delta_size);
+
+  std::lock_guard lk{s_rewind_mutex};
+
+  if (!delta.compressed_state.empty() &&
+      (delta.memory_delta_size == 0 || !delta.compressed_memory.empty()))
+  {
+    s_rewind_memory_usage += delta.compressed_state.size() + delta.compressed_memory.size();
+    s_rewind_deltas.push_back(std::move(delta));
+
+    while (s_rewind_memory_usage > args.memory_budget && !s_rewind_deltas.empty())
+    {
+      const RewindDelta& oldest = s_rewind_deltas.front();
+      s_rewind_memory_usage -= oldest.compressed_state.size() + oldest.compressed_memory.size();
+      s_rewind_deltas.pop_front();
+    }
+  }
+  else
+  {
+    // The older snapshots can't be reached without this delta.
+    s_rewind_deltas.clear();
+    s_rewind_memory_usage = 0;
+  }
+
+  s_rewind_spare_buffer = std::move(args.previous);
+  s_rewind_spare_memory_delta = std::move(args.memory_delta);
+}
+
+static void ClearRewindBuffer()
+{
+  s_rewind_thread.WaitForCompletion();
+
+  s_rewind_reference.reset();
+  s_rewind_reference_size = 0;
+  s_rewind_memory.reset();
+  s_rewind_dirty_pages.clear();
+  s_rewind_frames_since_reference = 0;
+
+  std::lock_guard lk{s_rewind_mutex};
+  s_rewind_deltas.clear();
+  s_rewind_memory_usage = 0;
+  s_rewind_spare_buffer.reset();
+  s_rewind_spare_memory_delta.reset();
+}
+
+static void CaptureRewindSnapshot(Core::System& system)
+{
+  // The worker might still be computing a delta against the current reference.
+  s_rewind_thread.WaitForCompletion();
+
+  auto& memory = system.GetMemory();
+  const u32 page_count = memory.GetStatePageCount();
+  if (s_rewind_memory.size() != page_count * REWIND_PAGE_SIZE)
+  {
+    ClearRewindBuffer();
+    s_rewind_memory.reset(page_count * REWIND_PAGE_SIZE);
+  }
+  const bool is_first_snapshot = s_rewind_reference_size == 0;
+
+  Common::UniqueBuffer<u8> buffer;
+  Common::UniqueBuffer<u8> memory_delta;
+  {
+    std::lock_guard lk{s_rewind_mutex};
+    buffer = std::move(s_rewind_spare_buffer);
+    memory_delta = std::move(s_rewind_spare_memory_delta);
+  }
+
+  // Same as Core::PauseAndLock, except that this already runs on the CPU thread between two
+  // blocks, so only the DSP and GPU threads need to be stopped before their state is saved.
+  auto& dsp = *system.GetDSP().GetDSPEmulator();
+  auto& fifo = system.GetFifo();
+  dsp.PauseAndLock();
+  fifo.PauseAndLock();
+  Common::ScopeGuard unpause_guard([&] {
+    fifo.RestoreState(true);
+    dsp.UnpauseAndUnlock();
+  });
+
+  std::size_t size;
+  {
+    // Rewind snapshots leave emulated memory out. Memory::EstimateStateSize() accounts for that,
+    // so this doesn't skew the size estimate used for regular savestates.
+    memory.SetExternalStateContents(s_rewind_memory);
+    Common::ScopeGuard guard([&] { memory.SetExternalStateContents({}); });
+    size = SaveToBuffer(system, buffer);
+  }
+  if (size == 0)
+    return;
+
+  // The GPU thread writes to emulated memory too, so it needs to be idle while the dirty pages are
+  // collected or its writes could get lost.
+  AsyncRequests::GetInstance()->PushBlockingEvent([&memory] {
+    const bool was_write_tracking_enabled = memory.IsWriteTrackingEnabled();
+    memory.CollectDirtyPages(s_rewind_dirty_pages);
+    if (!was_write_tracking_enabled)
+      memory.EnableWriteTracking();
+  });
+  if (is_first_snapshot)
+    std::fill(s_rewind_dirty_pages.begin(), s_rewind_dirty_pages.end(), true);
+
+  std::size_t memory_delta_size = 0;
+  if (!is_first_snapshot)
+  {
+    const auto dirty_page_count =
+        static_cast<std::size_t>(std::ranges::count(s_rewind_dirty_pages, true));
+    if (memory_delta.size() < dirty_page_count * REWIND_PAGE_RECORD_SIZE)
+      memory_delta.reset(dirty_page_count * REWIND_PAGE_RECORD_SIZE);
+  }
+
+  for (u32 i = 0; i < page_count; ++i)
+  {
+    if (!s_rewind_dirty_pages[i])
+      continue;
+
+    const u8* const page = memory.GetStatePage(i);
+    u8* const copy = s_rewind_memory.data() + i * REWIND_PAGE_SIZE;
+    if (!is_first_snapshot)
+    {
+      if (std::memcmp(page, copy, REWIND_PAGE_SIZE) == 0)
+        continue;
+
+      u8* const record = memory_delta.data() + memory_delta_size;
+      std::memcpy(record, &i, sizeof(u32));
+      std::memcpy(record + sizeof(u32), copy, REWIND_PAGE_SIZE);
+      XorIntoBuffer(record + sizeof(u32), {page, REWIND_PAGE_SIZE});
+      memory_delta_size += REWIND_PAGE_RECORD_SIZE;
+    }
+    std::memcpy(copy, page, REWIND_PAGE_SIZE);
+  }
+
+  // Only now can the GPU thread write to emulated memory again. Its writes mark the pages dirty for
+  // the next snapshot, but they must not make it into the copy for this one.
+  unpause_guard.Exit();
+
+  if (!is_first_snapshot)
+  {
+    const std::size_t memory_budget =
+        std::size_t(Config::Get(Config::MAIN_REWIND_MEMORY_BUDGET)) * 1024 * 1024;
+    s_rewind_thread.EmplaceItem(CompressRewindDeltaArgs{
+        std::move(s_rewind_reference), s_rewind_reference_size, {buffer.data(), size},
+        std::move(memory_delta), memory_delta_size, memory_budget});
+  }
+  else
+  {
+    std::lock_guard lk{s_rewind_mutex};
+    s_rewind_spare_memory_delta = std::move(memory_delta);
+  }
+
+  // Moving the buffer doesn't move its data, so the span handed to the worker stays valid.
+  s_rewind_reference = std::move(buffer);
+  s_rewind_reference_size = size;
+}
+
+// Replaces the reference snapshot with the one before it.
+static bool StepBackRewindReference()
+{
+  RewindDelta delta;
+  Common::UniqueBuffer<u8> buffer;
+  Common::UniqueBuffer<u8> memory_delta;
+  {
+    std::lock_guard lk{s_rewind_mutex};
+    if (s_rewind_deltas.empty())
+      return false;
+
+    delta = std::move(s_rewind_deltas.back());
+    s_rewind_deltas.pop_back();
+    s_rewind_memory_usage -= delta.compressed_state.size() + delta.compressed_memory.size();
+    buffer = std::move(s_rewind_spare_buffer);
+    memory_delta = std::move(s_rewind_spare_memory_delta);
+  }
+
+  if (!DecompressRewindData(delta.compressed_state, delta.state_delta_size, buffer) ||
+      !DecompressRewindData(delta.compressed_memory, delta.memory_delta_size, memory_delta))
+  {
+    // The older snapshots can't be reached without this delta.
+    std::lock_guard lk{s_rewind_mutex};
+    s_rewind_deltas.clear();
+    s_rewind_memory_usage = 0;
+    return false;
+  }
+
+  PrepareDeltaBuffer(s_rewind_reference, s_rewind_reference_size, delta.state_delta_size);
+  XorIntoBuffer(s_rewind_reference.data(), {buffer.data(), delta.state_delta_size});
+  s_rewind_reference_size = delta.state_size;
+
+  const std::size_t page_count = s_rewind_memory.size() / REWIND_PAGE_SIZE;
+  for (std::size_t offset = 0; offset < delta.memory_delta_size; offset += REWIND_PAGE_RECORD_SIZE)
+  {
+    u32 index;
+    std::memcpy(&index, memory_delta.data() + offset, sizeof(u32));
+    if (index < page_count)
+    {
+      XorIntoBuffer(s_rewind_memory.data() + index * REWIND_PAGE_SIZE,
+                    {memory_delta.data() + offset + sizeof(u32), REWIND_PAGE_SIZE});
+    }
+  }
+
+  std::lock_guard lk{s_rewind_mutex};
+  s_rewind_spare_buffer = std::move(buffer);
+  s_rewind_spare_memory_delta = std::move(memory_delta);
+  return true;
+}
+
+void UpdateRewindBuffer(Core::System& system)
+{
+  if (!Config::Get(Config::MAIN_REWIND_ENABLED))
+  {
+    if (s_rewind_reference_size != 0)
+    {
+      ClearRewindBuffer();
+      system.GetMemory().DisableWriteTracking();
+    }
+    return;
+  }
+
+  if (NetPlay::IsNetPlayRunning() || AchievementManager::GetInstance().IsHardcoreModeActive())
+    return;
+
+  const u32 interval = std::max(Config::Get(Config::MAIN_REWIND_FRAME_INTERVAL), 1u);
+  if (++s_rewind_frames_since_reference < interval)
+    return;
+  s_rewind_frames_since_reference = 0;
+
+  // We are in the middle of CoreTiming::Advance here, where the timing state can't be saved.
+  // Take the snapshot once the CPU thread is back at a block boundary.
+  system.GetCPU().YieldToCPUThreadJob([&system] { CaptureRewindSnapshot(system); });
+}
+
+void Rewind(Core::System& system)
+{
+  if (!CheckIfStateLoadIsAllowed(system))
+    return;
+
+  Core::RunOnCPUThread(system, [&system] {
+    // The input log can't be rewound along with the state.
+    if (system.GetMovie().IsMovieActive())
+    {
+      Core::DisplayMessage("Rewinding is disabled while a movie is active", 2000);
+      return;
+    }
+
+    s_rewind_thread.WaitForCompletion();
+
+    if (s_rewind_reference_size == 0)
+    {
+      Core::DisplayMessage("There is nothing to rewind to", 2000);
+      return;
+    }
+
+    // If the newest snapshot was only just taken or restored, go past it, so that repeatedly
+    // rewinding keeps stepping further back.
+    const u32 interval = std::max(Config::Get(Config::MAIN_REWIND_FRAME_INTERVAL), 1u);
+    if (s_rewind_frames_since_reference < (interval + 1) / 2 && !StepBackRewindReference())
+      Core::DisplayMessage("Reached the oldest rewind snapshot", 2000);
+
+    bool loaded_successfully;
+    {
+      auto& memory = system.GetMemory();
+      memory.SetExternalStateContents(s_rewind_memory);
+      Common::ScopeGuard guard([&memory] { memory.SetExternalStateContents({}); });
+      loaded_successfully =
+          LoadFromBuffer(system, {s_rewind_reference.data(), s_rewind_reference_size});
+    }
+
+    if (!loaded_successfully)
+    {
+      Core::DisplayMessage("The rewind snapshot could not be loaded", OSD::Duration::NORMAL);
+      ClearRewindBuffer();
+      system.GetMemory().DisableWriteTracking();
+      return;
+    }
+
+    s_rewind_frames_since_reference = 0;
+
+    if (s_on_after_load_callback)
+      s_on_after_load_callback();
+  });
+}
+
 void Init(Core::System& system)
 {
   s_compress_and_dump_thread.Reset("Savestate Worker",
                                    std::bind_front(&CompressAndDumpState, std::ref(system)));
+  s_rewind_thread.Reset("Rewind Worker", &CompressRewindDelta);
 
   s_flush_unsaved_data_hook = UICommon::AddFlushUnsavedDataCallback([] {
     // Holding the lock for any amount of time means there are no pending state save tasks.
@@ -895,6 +1833,9 @@ void Init(Core::System& system)
 void Shutdown()
 {
   s_compress_and_dump_thread.Shutdown();
+  s_rewind_thread.Shutdown();
+  ClearRewindBuffer();
+  s_rewind_compress_buffer.reset();
   s_undo_load_buffer.reset();
   s_flush_unsaved_data_hook.reset();
 }
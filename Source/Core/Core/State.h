@@ -7,8 +7,11 @@
 
 #include <cstddef>
 #include <functional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 
@@ -54,6 +57,10 @@ enum CompressionType : u16
 {
   Uncompressed = 0,
   LZ4 = 1,
+  // LZ4, split into independently compressed chunks that are listed in a StateChunkTableHeader.
+  ChunkedLZ4 = 2,
+  // Like ChunkedLZ4, but with zstd. Chunks may use the dictionary of the game.
+  ChunkedZstd = 3,
   // Add new compression types after this, as the compression type
   // is numerically stored in the state file.
 };
@@ -71,6 +78,17 @@ static_assert(offsetof(StateExtendedBaseHeader, payload_offset) == 4);
 static_assert(offsetof(StateExtendedBaseHeader, uncompressed_size) == 8);
 static_assert(std::is_trivially_copyable_v<StateExtendedBaseHeader>);
 
+// Starts the payload of states that use chunked compression. It is followed by a table of
+// chunk_count u32s holding the compressed size of each chunk, and then by the chunks themselves.
+// Every chunk except the last one decompresses to chunk_size bytes.
+struct StateChunkTableHeader
+{
+  u32 chunk_size;
+  u32 chunk_count;
+};
+static_assert(sizeof(StateChunkTableHeader) == 8);
+static_assert(std::is_trivially_copyable_v<StateChunkTableHeader>);
+
 struct StateExtendedHeader
 {
   StateExtendedBaseHeader base_header;
@@ -103,6 +121,26 @@ void SaveFirstSaved(Core::System& system);
 void UndoSaveState(Core::System& system);
 void UndoLoadState(Core::System& system);
 
+// Takes a rewind snapshot every MAIN_REWIND_FRAME_INTERVAL frames while rewinding is enabled.
+// Must be called on the CPU thread at the end of each frame.
+void UpdateRewindBuffer(Core::System& system);
+// Loads the most recent rewind snapshot. Calling it again right after steps further back.
+void Rewind(Core::System& system);
+
+// Path of the optional zstd dictionary that is used for the ChunkedZstd states of the given game.
+std::string GetCompressionDictionaryPath(std::string_view game_id);
+
+// These work on the state files of any game, and don't need the emulation to be running.
+// read_dictionary is only used for states that were compressed with a dictionary.
+// Writes the recompressed state to output_path, which must not be path, and deletes it on failure.
+bool RecompressStateFile(const std::string& path, const std::string& output_path,
+                         CompressionType compression_type, int compression_level,
+                         std::span<const u8> read_dictionary, std::span<const u8> write_dictionary);
+// Returns an empty vector on failure.
+std::vector<u8> TrainCompressionDictionary(std::span<const std::string> paths,
+                                           std::size_t dictionary_size,
+                                           std::span<const u8> read_dictionary);
+
 // for calling back into UI code without introducing a dependency on it in core
 using AfterLoadCallbackFunc = std::function<void()>;
 void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback);
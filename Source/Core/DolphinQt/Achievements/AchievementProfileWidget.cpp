@@ -0,0 +1,184 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef USE_RETRO_ACHIEVEMENTS
+#include "DolphinQt/Achievements/AchievementProfileWidget.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <QCheckBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QSignalBlocker>
+#include <QString>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "Core/AchievementManager.h"
+
+#include "DolphinQt/QtUtils/DolphinFileDialog.h"
+#include "DolphinQt/QtUtils/ModalMessageBox.h"
+
+AchievementProfileWidget::AchievementProfileWidget(QWidget* parent) : QWidget(parent)
+{
+  CreateLayout();
+  ConnectWidgets();
+  UpdateData();
+}
+
+void AchievementProfileWidget::CreateLayout()
+{
+  m_enabled_input = new QCheckBox(tr("Enable Evaluation Profiling"));
+  m_enabled_input->setToolTip(
+      tr("Measures how many memory reads and how much time each achievement, leaderboard and rich "
+         "presence script costs to evaluate.<br><br>Profiling evaluates every definition a second "
+         "time, so it slows down achievement processing while enabled."));
+  m_reset_button = new QPushButton(tr("Reset"));
+  m_export_button = new QPushButton(tr("Export..."));
+  m_summary_label = new QLabel();
+
+  m_table = new QTableWidget(0, 8, this);
+  m_table->setHorizontalHeaderLabels({tr("Type"), tr("ID"), tr("Title"), tr("Evaluations"),
+                                      tr("Peeks"), tr("Bytes Read"), tr("Total Time (ms)"),
+                                      tr("Average Time (µs)")});
+  m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+  m_table->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch);
+  m_table->horizontalHeader()->setHighlightSections(false);
+  m_table->verticalHeader()->hide();
+  m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+  m_table->setMinimumHeight(300);
+
+  m_timer = new QTimer(this);
+  m_timer->setInterval(1000);
+
+  auto* button_layout = new QHBoxLayout;
+  button_layout->addWidget(m_enabled_input);
+  button_layout->addStretch();
+  button_layout->addWidget(m_reset_button);
+  button_layout->addWidget(m_export_button);
+
+  auto* layout = new QVBoxLayout;
+  layout->setContentsMargins(0, 0, 0, 0);
+  layout->addLayout(button_layout);
+  layout->addWidget(m_summary_label);
+  layout->addWidget(m_table);
+  setLayout(layout);
+}
+
+void AchievementProfileWidget::ConnectWidgets()
+{
+  connect(m_enabled_input, &QCheckBox::toggled, this,
+          &AchievementProfileWidget::OnProfilingToggled);
+  connect(m_reset_button, &QPushButton::clicked, this, &AchievementProfileWidget::OnReset);
+  connect(m_export_button, &QPushButton::clicked, this, &AchievementProfileWidget::OnExport);
+  connect(m_timer, &QTimer::timeout, this, &AchievementProfileWidget::UpdateData);
+}
+
+void AchievementProfileWidget::OnProfilingToggled(bool enabled)
+{
+  AchievementManager::GetInstance().SetEvaluationProfilingEnabled(enabled);
+  UpdateData();
+}
+
+void AchievementProfileWidget::OnReset()
+{
+  AchievementManager::GetInstance().ResetEvaluationProfile();
+  UpdateData();
+}
+
+void AchievementProfileWidget::OnExport()
+{
+  const QString path = DolphinFileDialog::getSaveFileName(
+      this, tr("Export Evaluation Profile"), QString(), tr("JSON Files (*.json);;All Files (*)"));
+  if (path.isEmpty())
+    return;
+
+  if (!AchievementManager::GetInstance().DumpEvaluationProfile(path.toStdString()))
+  {
+    ModalMessageBox::critical(this, tr("Error"),
+                              tr("Failed to export the evaluation profile to %1.").arg(path));
+  }
+}
+
+static QString GetTypeName(AchievementManager::EvaluationProfileEntry::Type type)
+{
+  switch (type)
+  {
+  case AchievementManager::EvaluationProfileEntry::Type::Achievement:
+    return QObject::tr("Achievement");
+  case AchievementManager::EvaluationProfileEntry::Type::Leaderboard:
+    return QObject::tr("Leaderboard");
+  case AchievementManager::EvaluationProfileEntry::Type::RichPresence:
+    return QObject::tr("Rich Presence");
+  }
+  return {};
+}
+
+static QTableWidgetItem* CreateNumberItem(const QString& text)
+{
+  auto* item = new QTableWidgetItem(text);
+  item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+  return item;
+}
+
+void AchievementProfileWidget::UpdateData()
+{
+  using Micro = std::chrono::duration<double, std::micro>;
+  using Milli = std::chrono::duration<double, std::milli>;
+
+  auto& instance = AchievementManager::GetInstance();
+  const bool enabled = instance.IsEvaluationProfilingEnabled();
+  {
+    const QSignalBlocker blocker(m_enabled_input);
+    m_enabled_input->setChecked(enabled);
+  }
+  m_reset_button->setEnabled(enabled);
+  m_export_button->setEnabled(enabled);
+
+  // Profiling can already be enabled when this widget is created, so the timer follows whatever
+  // state is found here rather than only the checkbox.
+  if (!enabled)
+    m_timer->stop();
+  else if (!m_timer->isActive())
+    m_timer->start();
+
+  AchievementManager::EvaluationProfile profile = instance.GetEvaluationProfile();
+  if (profile.frames != 0)
+  {
+    m_summary_label->setText(tr("%1 frames profiled, %2 µs per frame spent evaluating the set")
+                                 .arg(profile.frames)
+                                 .arg(Micro(profile.frame_time).count() / profile.frames, 0, 'f',
+                                      1));
+  }
+  else
+  {
+    m_summary_label->setText(enabled ? tr("No frames profiled yet.") : QString());
+  }
+
+  // The most expensive definitions are the interesting ones.
+  std::ranges::sort(profile.entries, std::ranges::greater{},
+                    &AchievementManager::EvaluationProfileEntry::time);
+
+  m_table->setRowCount(static_cast<int>(profile.entries.size()));
+  for (int row = 0; row < static_cast<int>(profile.entries.size()); ++row)
+  {
+    const auto& entry = profile.entries[row];
+    const double average =
+        entry.evaluations != 0 ? Micro(entry.time).count() / entry.evaluations : 0.0;
+    m_table->setItem(row, 0, new QTableWidgetItem(GetTypeName(entry.type)));
+    m_table->setItem(row, 1, CreateNumberItem(QString::number(entry.id)));
+    m_table->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(entry.title)));
+    m_table->setItem(row, 3, CreateNumberItem(QString::number(entry.evaluations)));
+    m_table->setItem(row, 4, CreateNumberItem(QString::number(entry.peeks)));
+    m_table->setItem(row, 5, CreateNumberItem(QString::number(entry.bytes_read)));
+    m_table->setItem(row, 6, CreateNumberItem(QString::number(Milli(entry.time).count(), 'f', 3)));
+    m_table->setItem(row, 7, CreateNumberItem(QString::number(average, 'f', 2)));
+  }
+}
+
+#endif  // USE_RETRO_ACHIEVEMENTS
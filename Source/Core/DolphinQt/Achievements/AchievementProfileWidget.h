@@ -0,0 +1,38 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#ifdef USE_RETRO_ACHIEVEMENTS
+#include <QWidget>
+
+class QCheckBox;
+class QLabel;
+class QPushButton;
+class QTableWidget;
+class QTimer;
+
+class AchievementProfileWidget final : public QWidget
+{
+  Q_OBJECT
+public:
+  explicit AchievementProfileWidget(QWidget* parent);
+  void UpdateData();
+
+private:
+  void CreateLayout();
+  void ConnectWidgets();
+
+  void OnProfilingToggled(bool enabled);
+  void OnReset();
+  void OnExport();
+
+  QCheckBox* m_enabled_input;
+  QPushButton* m_reset_button;
+  QPushButton* m_export_button;
+  QLabel* m_summary_label;
+  QTableWidget* m_table;
+  QTimer* m_timer;
+};
+
+#endif  // USE_RETRO_ACHIEVEMENTS
@@ -18,6 +18,7 @@
 
 #include "DolphinQt/Achievements/AchievementHeaderWidget.h"
 #include "DolphinQt/Achievements/AchievementLeaderboardWidget.h"
+#include "DolphinQt/Achievements/AchievementProfileWidget.h"
 #include "DolphinQt/Achievements/AchievementProgressWidget.h"
 #include "DolphinQt/Achievements/AchievementSettingsWidget.h"
 #include "DolphinQt/QtUtils/QueueOnObject.h"
@@ -61,6 +62,8 @@ void AchievementsWindow::CreateMainLayout()
   m_tab_widget->addTab(GetWrappedWidget(m_settings_widget), tr("Settings"));
   m_tab_widget->addTab(GetWrappedWidget(m_progress_widget), tr("Progress"));
   m_tab_widget->addTab(GetWrappedWidget(m_leaderboard_widget), tr("Leaderboards"));
+  m_profile_widget = new AchievementProfileWidget(m_tab_widget);
+  m_tab_widget->addTab(m_profile_widget, tr("Profiler"));
 
   m_button_box = new QDialogButtonBox(QDialogButtonBox::Close);
 
@@ -73,6 +76,7 @@ void AchievementsWindow::CreateMainLayout()
 
   m_tab_widget->setTabVisible(1, is_game_loaded);
   m_tab_widget->setTabVisible(2, is_game_loaded);
+  m_tab_widget->setTabVisible(3, is_game_loaded);
 }
 
 void AchievementsWindow::ConnectWidgets()
@@ -88,6 +92,7 @@ void AchievementsWindow::UpdateData(AchievementManager::UpdatedItems updated_ite
     m_header_widget->UpdateData();
     m_progress_widget->UpdateData(true);
     m_leaderboard_widget->UpdateData(true);
+    m_profile_widget->UpdateData();
     static_cast<QScrollArea*>(m_tab_widget->widget(1))->verticalScrollBar()->setValue(0);
     static_cast<QScrollArea*>(m_tab_widget->widget(2))->verticalScrollBar()->setValue(0);
   }
@@ -115,6 +120,7 @@ void AchievementsWindow::UpdateData(AchievementManager::UpdatedItems updated_ite
     m_header_widget->setVisible(instance.HasAPIToken());
     m_tab_widget->setTabVisible(1, is_game_loaded);
     m_tab_widget->setTabVisible(2, is_game_loaded);
+    m_tab_widget->setTabVisible(3, is_game_loaded);
   }
   update();
 }
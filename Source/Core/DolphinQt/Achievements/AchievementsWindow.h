@@ -11,6 +11,7 @@
 
 class AchievementHeaderWidget;
 class AchievementLeaderboardWidget;
+class AchievementProfileWidget;
 class AchievementSettingsWidget;
 class AchievementProgressWidget;
 class QDialogButtonBox;
@@ -35,6 +36,7 @@ private:
   AchievementSettingsWidget* m_settings_widget;
   AchievementProgressWidget* m_progress_widget;
   AchievementLeaderboardWidget* m_leaderboard_widget;
+  AchievementProfileWidget* m_profile_widget;
   QDialogButtonBox* m_button_box;
 
   Common::EventHook m_event_hook;
@@ -190,6 +190,13 @@ void JITWidget::ShowFreeMemoryStatus()
                        .arg(QtUtils::FromStdString(name))
                        .arg(fragmentation_ratio * 100.0, 0, 'f', 2));
   }
+  const JitCodeSpaceStats code_space_stats = m_system.GetJitInterface().GetCodeSpaceStats();
+  // i18n: %1 is how often the whole JIT cache was cleared because it was full, %2 is how often
+  // only the least recently used code was evicted instead, and %3 is the number of evicted blocks.
+  message.append(tr(" | Full flushes: %1, partial evictions: %2 (%3 blocks)")
+                     .arg(code_space_stats.full_flushes)
+                     .arg(code_space_stats.partial_evictions)
+                     .arg(code_space_stats.evicted_blocks));
   m_status_bar->showMessage(message);
 }
 
@@ -639,6 +646,8 @@ JITWidget::JITWidget(Core::System& system, QWidget* parent) : QDockWidget(parent
       QT_TR_NOOP("Host Near Code Size"),
       // i18n: "Far Code" refers to the far code cache of Dolphin's JITs.
       QT_TR_NOOP("Host Far Code Size"),
+      // i18n: Register stores that block exits leave out because the next block overwrites them.
+      QT_TR_NOOP("Skipped Exit Stores"),
       QT_TR_NOOP("Run Count"),
       // i18n: "Cycles" means instruction cycles.
       QT_TR_NOOP("Cycles Spent"),
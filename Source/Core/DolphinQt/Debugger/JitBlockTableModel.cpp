@@ -242,6 +242,8 @@ QVariant JitBlockTableModel::DisplayRoleData(const QModelIndex& index) const
     return QString::number(jit_block.near_end - jit_block.near_begin);
   case Column::HostFarCodeSize:
     return QString::number(jit_block.far_end - jit_block.far_begin);
+  case Column::SkippedExitStores:
+    return QString::number(jit_block.skipped_exit_stores);
   }
   const JitBlock::ProfileData* const profile_data = jit_block.profile_data.get();
   if (profile_data == nullptr)
@@ -284,7 +286,7 @@ QVariant JitBlockTableModel::DisplayRoleData(const QModelIndex& index) const
         100.0 * profile_data->time_spent.count() / m_overall_time_spent.count(), 10, 'f', 6);
   }
   }
-  static_assert(Column::NumberOfColumns == 14);
+  static_assert(Column::NumberOfColumns == 15);
   std::unreachable();
 }
 
@@ -299,6 +301,7 @@ QVariant JitBlockTableModel::TextAlignmentRoleData(const QModelIndex& index) con
   case Column::RepeatInstructions:
   case Column::HostNearCodeSize:
   case Column::HostFarCodeSize:
+  case Column::SkippedExitStores:
   case Column::RunCount:
   case Column::CyclesSpent:
   case Column::CyclesAverage:
@@ -310,7 +313,7 @@ QVariant JitBlockTableModel::TextAlignmentRoleData(const QModelIndex& index) con
   case Column::Symbol:
     return QVariant::fromValue(Qt::AlignLeft | Qt::AlignVCenter);
   }
-  static_assert(Column::NumberOfColumns == 14);
+  static_assert(Column::NumberOfColumns == 15);
   std::unreachable();
 }
 
@@ -337,6 +340,8 @@ QVariant JitBlockTableModel::SortRoleData(const QModelIndex& index) const
     return static_cast<qulonglong>(jit_block.near_end - jit_block.near_begin);
   case Column::HostFarCodeSize:
     return static_cast<qulonglong>(jit_block.far_end - jit_block.far_begin);
+  case Column::SkippedExitStores:
+    return static_cast<qulonglong>(jit_block.skipped_exit_stores);
   }
   const JitBlock::ProfileData* const profile_data = jit_block.profile_data.get();
   if (profile_data == nullptr)
@@ -360,7 +365,7 @@ QVariant JitBlockTableModel::SortRoleData(const QModelIndex& index) const
       return QVariant();
     return static_cast<double>(profile_data->time_spent.count()) / profile_data->run_count;
   }
-  static_assert(Column::NumberOfColumns == 14);
+  static_assert(Column::NumberOfColumns == 15);
   std::unreachable();
 }
 
@@ -397,6 +402,8 @@ QVariant JitBlockTableModel::headerData(int section, Qt::Orientation orientation
       QT_TR_NOOP("Host N. Size"),
       // i18n: Host Far Code Size
       QT_TR_NOOP("Host F. Size"),
+      // i18n: Skipped Exit Stores
+      QT_TR_NOOP("Skip. Exit Stores"),
       QT_TR_NOOP("Run Count"),
       QT_TR_NOOP("Cycles Spent"),
       // i18n: Cycles Average
@@ -30,6 +30,7 @@ enum EnumType : int
   RepeatInstructions,
   HostNearCodeSize,
   HostFarCodeSize,
+  SkippedExitStores,
   RunCount,
   CyclesSpent,
   CyclesAverage,
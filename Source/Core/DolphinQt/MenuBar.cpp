@@ -28,6 +28,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/Debugger/RSO.h"
+#include "Core/Debugger/SamplingProfiler.h"
 #include "Core/HLE/HLE.h"
 #include "Core/HW/AddressSpace.h"
 #include "Core/HW/Memmap.h"
@@ -159,6 +160,10 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_jit_search_instruction->setEnabled(running);
   m_jit_wipe_profiling_data->setEnabled(jit_exists);
   m_jit_write_cache_log_dump->setEnabled(jit_exists);
+  m_sampling_profiler_enable->setEnabled(running);
+  SignalBlocking(m_sampling_profiler_enable)
+      ->setChecked(Core::System::GetInstance().GetPowerPC().GetSamplingProfiler().IsRunning());
+  m_sampling_profiler_write->setEnabled(running);
 
   // Symbols
   m_symbols->setEnabled(running);
@@ -236,6 +241,45 @@ void MenuBar::OnWriteJitBlockLogDump()
   }
 }
 
+void MenuBar::OnToggleSamplingProfiler(bool enabled)
+{
+  auto& system = Core::System::GetInstance();
+  auto& sampling_profiler = system.GetPowerPC().GetSamplingProfiler();
+  if (enabled)
+  {
+    sampling_profiler.Clear(Core::CPUThreadGuard{system});
+    sampling_profiler.Start();
+  }
+  else
+  {
+    sampling_profiler.Stop();
+  }
+}
+
+void MenuBar::OnWriteSamplingProfile()
+{
+  const std::string filename = fmt::format("{}{}.folded", File::GetUserPath(D_DUMPDEBUG_IDX),
+                                           SConfig::GetInstance().GetGameID());
+  auto& system = Core::System::GetInstance();
+  auto& power_pc = system.GetPowerPC();
+  if (!power_pc.GetSamplingProfiler().ExportCollapsedStacks(
+          Core::CPUThreadGuard{system}, power_pc.GetSymbolDB(), filename))
+  {
+    ModalMessageBox::warning(
+        this, tr("Error"),
+        tr("Failed to write to \"%1\".").arg(QString::fromStdString(filename)));
+    return;
+  }
+  if (static bool ignore = false; ignore == false)
+  {
+    const int button_pressed = ModalMessageBox::information(
+        this, tr("Success"), tr("Wrote to \"%1\".").arg(QString::fromStdString(filename)),
+        QMessageBox::Ok | QMessageBox::Ignore);
+    if (button_pressed == QMessageBox::Ignore)
+      ignore = true;
+  }
+}
+
 void MenuBar::AddFileMenu()
 {
   QMenu* file_menu = addMenu(tr("&File"));
@@ -957,6 +1001,14 @@ void MenuBar::AddJITMenu()
 
   m_jit->addSeparator();
 
+  m_sampling_profiler_enable = m_jit->addAction(tr("Enable Sampling Profiler"));
+  m_sampling_profiler_enable->setCheckable(true);
+  connect(m_sampling_profiler_enable, &QAction::toggled, this, &MenuBar::OnToggleSamplingProfiler);
+  m_sampling_profiler_write =
+      m_jit->addAction(tr("Write Sampling Profile"), this, &MenuBar::OnWriteSamplingProfile);
+
+  m_jit->addSeparator();
+
   m_jit_off = m_jit->addAction(tr("JIT Off (JIT Core)"));
   m_jit_off->setCheckable(true);
   m_jit_off->setChecked(Config::Get(Config::MAIN_DEBUG_JIT_OFF));
@@ -201,6 +201,8 @@ private:
   void OnDebugModeToggled(bool enabled);
   void OnWipeJitBlockProfilingData();
   void OnWriteJitBlockLogDump();
+  void OnToggleSamplingProfiler(bool enabled);
+  void OnWriteSamplingProfile();
 
   QString GetSignatureSelector() const;
 
@@ -296,6 +298,8 @@ private:
   QAction* m_jit_profile_blocks;
   QAction* m_jit_wipe_profiling_data;
   QAction* m_jit_write_cache_log_dump;
+  QAction* m_sampling_profiler_enable;
+  QAction* m_sampling_profiler_write;
   QAction* m_jit_off;
   QAction* m_jit_loadstore_off;
   QAction* m_jit_loadstore_lbzx_off;
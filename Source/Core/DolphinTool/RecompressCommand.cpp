@@ -0,0 +1,282 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/RecompressCommand.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/StringUtil.h"
+#include "Core/State.h"
+#include "DiscIO/WIABlob.h"
+
+namespace DolphinTool
+{
+static std::optional<State::CompressionType>
+ParseCompressionTypeString(const std::string& compression_str)
+{
+  if (compression_str == "none")
+    return State::CompressionType::Uncompressed;
+  else if (compression_str == "lz4")
+    return State::CompressionType::ChunkedLZ4;
+  else if (compression_str == "zstd")
+    return State::CompressionType::ChunkedZstd;
+  return std::nullopt;
+}
+
+static std::optional<std::vector<u8>> ReadDictionary(const std::string& path)
+{
+  if (!File::Exists(path))
+    return std::vector<u8>{};
+
+  File::IOFile f(path, "rb");
+  std::vector<u8> dictionary(f.GetSize());
+  if (!f.ReadBytes(dictionary.data(), dictionary.size()))
+    return std::nullopt;
+  return dictionary;
+}
+
+// Returns a savestate slot of the dictionary's game, stored next to the dictionary, that isn't one
+// of the given states. Such a state may depend on the dictionary.
+static std::optional<std::string> FindOtherSlotState(const std::string& dictionary_path,
+                                                     const std::vector<std::string>& state_paths)
+{
+  const std::filesystem::path dictionary = StringToPath(dictionary_path);
+  const std::string slot_prefix = PathToString(dictionary.stem()) + ".s";
+
+  std::error_code error;
+  std::filesystem::directory_iterator it(dictionary.parent_path().empty() ?
+                                             std::filesystem::path(".") :
+                                             dictionary.parent_path(),
+                                         error);
+  for (; !error && it != std::filesystem::directory_iterator(); it.increment(error))
+  {
+    const std::string filename = PathToString(it->path().filename());
+    if (filename.size() != slot_prefix.size() + 2 || !filename.starts_with(slot_prefix) ||
+        !std::isdigit(static_cast<unsigned char>(filename[slot_prefix.size()])) ||
+        !std::isdigit(static_cast<unsigned char>(filename[slot_prefix.size() + 1])))
+    {
+      continue;
+    }
+
+    const bool is_recompressed = std::ranges::any_of(state_paths, [&](const std::string& path) {
+      std::error_code equivalent_error;
+      return std::filesystem::equivalent(StringToPath(path), it->path(), equivalent_error);
+    });
+    if (!is_recompressed)
+      return PathToString(it->path());
+  }
+  return std::nullopt;
+}
+
+int RecompressCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: recompress [options]... [FILE]...");
+
+  parser.add_option("-c", "--compression")
+      .type("string")
+      .action("store")
+      .help("Compression method to use for the savestates. Default is zstd. [%choices]")
+      .choices({"none", "lz4", "zstd"})
+      .set_default("zstd");
+
+  parser.add_option("-l", "--compression_level")
+      .type("int")
+      .action("store")
+      .help("Level of compression for zstd. Ignored otherwise. Default is 19.")
+      .set_default(19);
+
+  parser.add_option("-d", "--dictionary")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to a zstd dictionary FILE to compress the savestates with. Savestates "
+            "that were compressed with this dictionary can be read as well. To use it in Dolphin, "
+            "place it in the StateSaves folder as <game ID>.zdict.")
+      .metavar("FILE");
+
+  parser.add_option("-t", "--train")
+      .action("store_true")
+      .help("Optional. Train the dictionary from the given savestates before recompressing them, "
+            "replacing the dictionary FILE if it exists. The dictionary and the savestates are "
+            "only replaced if every savestate could be recompressed, and an existing dictionary "
+            "is only replaced if all of its game's savestate slots next to it are given.");
+
+  parser.add_option("-s", "--dictionary_size")
+      .type("int")
+      .action("store")
+      .help("Size of the trained dictionary, in bytes. Default is 262144 (256 KiB).")
+      .set_default(262144);
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  const std::vector<std::string>& state_paths = parser.args();
+  if (state_paths.empty())
+  {
+    fmt::print(std::cerr, "Error: No savestates set\n");
+    return EXIT_FAILURE;
+  }
+
+  // --compression, --compression_level
+  const std::optional<State::CompressionType> compression_o =
+      ParseCompressionTypeString(options["compression"]);
+  if (!compression_o.has_value())
+  {
+    fmt::print(std::cerr, "Error: Unknown compression method\n");
+    return EXIT_FAILURE;
+  }
+  const State::CompressionType compression = compression_o.value();
+
+  const int compression_level = static_cast<int>(options.get("compression_level"));
+  if (compression == State::CompressionType::ChunkedZstd)
+  {
+    const std::pair<int, int> range =
+        DiscIO::GetAllowedCompressionLevels(DiscIO::WIARVZCompressionType::Zstd, false);
+    if (compression_level < range.first || compression_level > range.second)
+    {
+      fmt::print(std::cerr, "Error: Compression level not in acceptable range\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  // --dictionary, --train, --dictionary_size
+  const std::string& dictionary_path = options["dictionary"];
+  const bool train = options.is_set_by_user("train");
+  if (train)
+  {
+    if (dictionary_path.empty())
+    {
+      fmt::print(std::cerr, "Error: Training requires a dictionary path\n");
+      return EXIT_FAILURE;
+    }
+
+    if (compression != State::CompressionType::ChunkedZstd)
+    {
+      fmt::print(std::cerr, "Error: Dictionaries are only supported for zstd\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  const int dictionary_size = static_cast<int>(options.get("dictionary_size"));
+  if (dictionary_size <= 0)
+  {
+    fmt::print(std::cerr, "Error: Dictionary size must be positive\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<u8> read_dictionary;
+  if (!dictionary_path.empty())
+  {
+    std::optional<std::vector<u8>> dictionary = ReadDictionary(dictionary_path);
+    if (!dictionary)
+    {
+      fmt::print(std::cerr, "Error: Unable to read the dictionary\n");
+      return EXIT_FAILURE;
+    }
+    read_dictionary = std::move(*dictionary);
+  }
+
+  if (train && !read_dictionary.empty())
+  {
+    if (const std::optional<std::string> other_state =
+            FindOtherSlotState(dictionary_path, state_paths))
+    {
+      fmt::print(std::cerr,
+                 "Error: {} may have been compressed with the dictionary, which would make it "
+                 "unreadable once the dictionary is replaced. Recompress it along with the others.\n",
+                 *other_state);
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<u8> write_dictionary = read_dictionary;
+  const std::string new_dictionary_path = dictionary_path + ".tmp";
+  if (train)
+  {
+    write_dictionary = State::TrainCompressionDictionary(
+        state_paths, static_cast<std::size_t>(dictionary_size), read_dictionary);
+    if (write_dictionary.empty())
+    {
+      fmt::print(std::cerr, "Error: Unable to train the dictionary\n");
+      return EXIT_FAILURE;
+    }
+
+    File::IOFile f(new_dictionary_path, "wb");
+    if (!f.WriteBytes(write_dictionary.data(), write_dictionary.size()) || !f.Close())
+    {
+      File::Delete(new_dictionary_path);
+      fmt::print(std::cerr, "Error: Unable to write the dictionary\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Perform the recompression. With a newly trained dictionary, the states and the dictionary
+  // are only replaced once every state was recompressed, so that a failure leaves all of them
+  // readable with the old dictionary.
+  bool success = true;
+  std::vector<std::string> recompressed_paths;
+  for (const std::string& path : state_paths)
+  {
+    const std::string output_path = path + ".tmp";
+    if (!State::RecompressStateFile(path, output_path, compression, compression_level,
+                                    read_dictionary, write_dictionary))
+    {
+      fmt::print(std::cerr, "Error: Recompressing {} failed\n", path);
+      success = false;
+    }
+    else if (train)
+    {
+      recompressed_paths.push_back(path);
+    }
+    else if (!File::Rename(output_path, path))
+    {
+      fmt::print(std::cerr, "Error: Replacing {} failed\n", path);
+      success = false;
+    }
+  }
+
+  if (train)
+  {
+    if (!success)
+    {
+      for (const std::string& path : recompressed_paths)
+        File::Delete(path + ".tmp");
+      File::Delete(new_dictionary_path);
+      fmt::print(std::cerr, "Error: The savestates and the dictionary were left unchanged\n");
+      return EXIT_FAILURE;
+    }
+
+    for (const std::string& path : recompressed_paths)
+    {
+      if (!File::Rename(path + ".tmp", path))
+      {
+        fmt::print(std::cerr, "Error: Replacing {} failed\n", path);
+        success = false;
+      }
+    }
+    if (!File::Rename(new_dictionary_path, dictionary_path))
+    {
+      fmt::print(std::cerr, "Error: Replacing the dictionary failed\n");
+      success = false;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace DolphinTool
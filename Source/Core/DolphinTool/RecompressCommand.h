@@ -0,0 +1,12 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace DolphinTool
+{
+int RecompressCommand(const std::vector<std::string>& args);
+}  // namespace DolphinTool
@@ -4,15 +4,24 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
 #include <vector>
 
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/WorkQueueThread.h"
+
+#include "Core/Config/GraphicsSettings.h"
 
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/SWEfbInterface.h"
 #include "VideoBackends/Software/Tev.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/PerfQueryBase.h"
@@ -24,6 +33,24 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// When several threads are used, the triangles of a batch are binned into square tiles of the EFB,
+// and each tile is drawn by one thread. Within a tile, triangles are drawn in the order they were
+// submitted, so every pixel goes through the same sequence of operations as when drawing on a
+// single thread. Tiles are made of whole blocks, so that no block is shared by two threads.
+//
+// Some state outlives a pixel (see Tev::CopyCarriedState and RasterBlock). Batches whose pixels
+// read what the previous pixel left behind are drawn by a single thread, and at the end of every
+// batch all threads take on the state that the pixel a single thread would have drawn last left
+// behind, so the output doesn't depend on the number of threads.
+static constexpr s32 TILE_SIZE = 32;
+static constexpr u32 TILES_X = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr u32 TILES_Y = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+static_assert(TILE_SIZE % BLOCK_SIZE == 0);
+
+// Batches whose bounding rectangles add up to fewer pixels than this are drawn by the GPU thread
+// alone, since waking up the workers would take longer than drawing them.
+static constexpr u32 MIN_PARALLEL_AREA = 0x4000;
+
 struct SlopeContext
 {
   SlopeContext(const OutputVertexData* v0, const OutputVertexData* v1, const OutputVertexData* v2,
@@ -95,21 +122,108 @@ struct Slope
   }
 };
 
-static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
+// Everything that's needed to draw a triangle within one of the scissor rectangles.
+struct TriangleSetup
+{
+  // Bounding rectangle, clipped to the scissor rectangle
+  s32 minx;
+  s32 maxx;
+  s32 miny;
+  s32 maxy;
+
+  // Half-edge constants and deltas, in 28.4 fixed point
+  s32 C1;
+  s32 C2;
+  s32 C3;
+  s32 DX12;
+  s32 DX23;
+  s32 DX31;
+  s32 DY12;
+  s32 DY23;
+  s32 DY31;
+
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+};
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// The state of a thread that draws pixels.
+struct DrawContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  u32 rasterized_pixels = 0;
+
+  // The pixel drawn and the block built most recently (see DrawOrderKey)
+  u64 pixel_key = 0;
+  u64 block_key = 0;
+
+  // Of the pixels drawn and blocks built by this context in the current batch, the ones that come
+  // last in submission order, and the state that they left behind. A context can go on to a tile
+  // whose pixels come earlier, so this is saved at the end of every tile.
+  u64 last_pixel_key = 0;
+  u64 last_block_key = 0;
+  Tev last_pixel_tev;
+  RasterBlock last_block;
+};
+
+static Slope ZSlope;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
+// Triangles of the current batch, in the order they were submitted
+static std::vector<TriangleSetup> triangles;
+static u64 triangles_area = 0;
+
+// Indices into triangles for each tile, and the tiles that have any
+static std::array<std::vector<u32>, TILES_X * TILES_Y> tile_bins;
+static std::vector<u32> active_tiles;
+static std::atomic<u32> next_active_tile;
+
+// The first context belongs to the GPU thread, and the others to the workers.
+static std::vector<std::unique_ptr<DrawContext>> contexts;
+using WorkerThread = Common::WorkQueueThreadSP<DrawContext*>;
+static std::vector<std::unique_ptr<WorkerThread>> workers;
+
+// Shared by the Tevs of all contexts, and set up at the start of each batch.
+static Tev::Pipeline tev_pipeline;
+
+static void DrawTiles(DrawContext& context);
+
 void Init()
 {
   // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
   // needs to be set to an (untested) default value.
   ZSlope = Slope();
+
+  // By default, leave one core for the CPU thread.
+  int num_threads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
+  if (num_threads <= 0)
+    num_threads = std::max(cpu_info.num_cores - 1, 1);
+
+  contexts.clear();
+  for (int i = 0; i < num_threads; ++i)
+  {
+    auto& context = contexts.emplace_back(std::make_unique<DrawContext>());
+    context->tev.SetPipeline(tev_pipeline);
+  }
+
+  workers.clear();
+  for (int i = 1; i < num_threads; ++i)
+  {
+    auto& worker = workers.emplace_back(std::make_unique<WorkerThread>());
+    worker->Reset("SW Rasterizer", [](DrawContext* context) { DrawTiles(*context); });
+  }
+}
+
+void Shutdown()
+{
+  workers.clear();
+  contexts.clear();
+  triangles.clear();
+  triangles_area = 0;
+  TextureSampler::ClearCache();
 }
 
 void ScissorChanged()
@@ -143,29 +257,45 @@ static inline int iround(float x)
 
 void SetTevKonstColors()
 {
-  tev.SetKonstColors();
+  for (auto& context : contexts)
+    context->tev.SetKonstColors();
+}
+
+// Orders pixels and blocks the way DrawTriangle goes through them when a single thread draws the
+// whole batch: by triangle, then by block row and block column, then by row and column within the
+// block. 0 stands for none.
+static u64 DrawOrderKey(u32 triangle_index, s32 x, s32 y)
+{
+  static_assert(BLOCK_SIZE == 2);
+  return (u64{triangle_index} + 1) << 32 | static_cast<u32>(y >> 1) << 11 |
+         static_cast<u32>(x >> 1) << 2 | static_cast<u32>(y & 1) << 1 | static_cast<u32>(x & 1);
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(DrawContext& context, u32 triangle_index, s32 x, s32 y, s32 xi, s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  ++context.rasterized_pixels;
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+  const TriangleSetup& triangle = triangles[triangle_index];
+
+  Tev& tev = context.tev;
+  const RasterBlock& rasterBlock = context.rasterBlock;
+
+  s32 z = (s32)std::clamp<float>(triangle.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
   {
     // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+    tev.IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
     if (bpmem.zmode.test_enable)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
         return;
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+    tev.IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -176,7 +306,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      const float color = ColorSlopes[i][comp].GetValue(x, y);
+      const float color = triangle.ColorSlopes[i][comp].GetValue(x, y);
       tev.Color[i][comp] = (u8)std::clamp<float>(color, 0.0f, 255.0f);
     }
   }
@@ -201,10 +331,12 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     tev.TextureLinear[i] = rasterBlock.TextureLinear[i];
   }
 
+  context.pixel_key = DrawOrderKey(triangle_index, x, y);
   tev.Draw();
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -215,9 +347,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
@@ -255,7 +387,8 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, const TriangleSetup& triangle, s32 blockX,
+                       s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -266,19 +399,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / triangle.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = triangle.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = triangle.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = triangle.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -288,7 +421,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -300,7 +434,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -346,15 +481,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-point deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -375,27 +501,47 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   if (minx >= maxx || miny >= maxy)
     return;
 
+  TriangleSetup& triangle = triangles.emplace_back();
+  triangles_area += static_cast<u64>(maxx - minx) * static_cast<u64>(maxy - miny);
+
+  triangle.minx = minx;
+  triangle.maxx = maxx;
+  triangle.miny = miny;
+  triangle.maxy = maxy;
+
+  triangle.DX12 = DX12;
+  triangle.DX23 = DX23;
+  triangle.DX31 = DX31;
+  triangle.DY12 = DY12;
+  triangle.DY23 = DY23;
+  triangle.DY31 = DY31;
+
   // Set up the remaining slopes
   const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
                          scissor.y_off);
 
+  triangle.ZSlope = ZSlope;
+
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
+  triangle.WSlope = Slope(w[0], w[1], w[2], ctx);
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    {
+      triangle.ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
-    TexSlopes[i][0] =
+    triangle.TexSlopes[i][0] =
         Slope(v0->texCoords[i].x * w[0], v1->texCoords[i].x * w[1], v2->texCoords[i].x * w[2], ctx);
-    TexSlopes[i][1] =
+    triangle.TexSlopes[i][1] =
         Slope(v0->texCoords[i].y * w[0], v1->texCoords[i].y * w[1], v2->texCoords[i].y * w[2], ctx);
-    TexSlopes[i][2] =
+    triangle.TexSlopes[i][2] =
         Slope(v0->texCoords[i].z * w[0], v1->texCoords[i].z * w[1], v2->texCoords[i].z * w[2], ctx);
   }
 
@@ -412,6 +558,39 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
     C3++;
 
+  triangle.C1 = C1;
+  triangle.C2 = C2;
+  triangle.C3 = C3;
+}
+
+// Draws the part of a triangle that lies within [minx, maxx) x [miny, maxy), which must be inside
+// the triangle's bounding rectangle.
+static void DrawTriangle(DrawContext& context, u32 triangle_index, s32 minx, s32 maxx, s32 miny,
+                         s32 maxy)
+{
+  const TriangleSetup& triangle = triangles[triangle_index];
+
+  const s32 C1 = triangle.C1;
+  const s32 C2 = triangle.C2;
+  const s32 C3 = triangle.C3;
+
+  const s32 DX12 = triangle.DX12;
+  const s32 DX23 = triangle.DX23;
+  const s32 DX31 = triangle.DX31;
+
+  const s32 DY12 = triangle.DY12;
+  const s32 DY23 = triangle.DY23;
+  const s32 DY31 = triangle.DY31;
+
+  // Fixed-point deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
   s32 block_miny = miny & ~(BLOCK_SIZE - 1);
@@ -453,7 +632,8 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(context.rasterBlock, triangle, x, y);
+      context.block_key = DrawOrderKey(triangle_index, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -463,7 +643,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(context, triangle_index, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -486,7 +666,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(context, triangle_index, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -503,6 +683,102 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+// Called once the context has drawn a run of pixels in submission order.
+static void SaveCarriedState(DrawContext& context)
+{
+  if (context.pixel_key > context.last_pixel_key)
+  {
+    context.last_pixel_key = context.pixel_key;
+    context.last_pixel_tev.CopyCarriedState(context.tev);
+  }
+  if (context.block_key > context.last_block_key)
+  {
+    context.last_block_key = context.block_key;
+    context.last_block = context.rasterBlock;
+  }
+}
+
+static void DrawTiles(DrawContext& context)
+{
+  for (u32 i = next_active_tile++; i < active_tiles.size(); i = next_active_tile++)
+  {
+    const u32 tile = active_tiles[i];
+    const s32 tile_minx = static_cast<s32>(tile % TILES_X) * TILE_SIZE;
+    const s32 tile_miny = static_cast<s32>(tile / TILES_X) * TILE_SIZE;
+
+    for (const u32 index : tile_bins[tile])
+    {
+      const TriangleSetup& triangle = triangles[index];
+      DrawTriangle(context, index, std::max(triangle.minx, tile_minx),
+                   std::min(triangle.maxx, tile_minx + TILE_SIZE),
+                   std::max(triangle.miny, tile_miny),
+                   std::min(triangle.maxy, tile_miny + TILE_SIZE));
+    }
+
+    SaveCarriedState(context);
+  }
+}
+
+static void BinTriangles()
+{
+  for (u32 index = 0; index < triangles.size(); ++index)
+  {
+    const TriangleSetup& triangle = triangles[index];
+    const u32 first_tile_x = static_cast<u32>(triangle.minx / TILE_SIZE);
+    const u32 last_tile_x = static_cast<u32>((triangle.maxx - 1) / TILE_SIZE);
+    const u32 first_tile_y = static_cast<u32>(triangle.miny / TILE_SIZE);
+    const u32 last_tile_y = static_cast<u32>((triangle.maxy - 1) / TILE_SIZE);
+
+    for (u32 tile_y = first_tile_y; tile_y <= last_tile_y; ++tile_y)
+    {
+      for (u32 tile_x = first_tile_x; tile_x <= last_tile_x; ++tile_x)
+      {
+        const u32 tile = tile_y * TILES_X + tile_x;
+        if (tile_bins[tile].empty())
+          active_tiles.push_back(tile);
+        tile_bins[tile].push_back(index);
+      }
+    }
+  }
+}
+
+// Gives every context the state that a single thread would have been left with after drawing the
+// batch.
+static void SyncCarriedState()
+{
+  const DrawContext* last_pixel_context = nullptr;
+  const DrawContext* last_block_context = nullptr;
+  for (const auto& context : contexts)
+  {
+    if (context->last_pixel_key != 0 &&
+        (!last_pixel_context || context->last_pixel_key > last_pixel_context->last_pixel_key))
+    {
+      last_pixel_context = context.get();
+    }
+    if (context->last_block_key != 0 &&
+        (!last_block_context || context->last_block_key > last_block_context->last_block_key))
+    {
+      last_block_context = context.get();
+    }
+  }
+
+  for (auto& context : contexts)
+  {
+    if (last_pixel_context)
+      context->tev.CopyCarriedState(last_pixel_context->last_pixel_tev);
+    if (last_block_context)
+      context->rasterBlock = last_block_context->last_block;
+  }
+
+  for (auto& context : contexts)
+  {
+    context->pixel_key = 0;
+    context->block_key = 0;
+    context->last_pixel_key = 0;
+    context->last_block_key = 0;
+  }
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
@@ -511,4 +787,53 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   for (const auto& scissor : scissors)
     DrawTriangleFrontFace(v0, v1, v2, scissor);
 }
+
+void Flush()
+{
+  if (triangles.empty())
+    return;
+
+  Tev::SetupPipeline(tev_pipeline);
+  TextureSampler::BindTextures(tev_pipeline.used_texmaps);
+
+  if (workers.empty() || triangles_area < MIN_PARALLEL_AREA ||
+      tev_pipeline.depends_on_previous_pixel)
+  {
+    for (u32 index = 0; index < triangles.size(); ++index)
+    {
+      const TriangleSetup& triangle = triangles[index];
+      DrawTriangle(*contexts[0], index, triangle.minx, triangle.maxx, triangle.miny,
+                   triangle.maxy);
+    }
+    SaveCarriedState(*contexts[0]);
+  }
+  else
+  {
+    BinTriangles();
+
+    next_active_tile = 0;
+    for (u32 i = 0; i < workers.size(); ++i)
+      workers[i]->Push(contexts[i + 1].get());
+    DrawTiles(*contexts[0]);
+    for (auto& worker : workers)
+      worker->WaitForCompletion();
+
+    for (const u32 tile : active_tiles)
+      tile_bins[tile].clear();
+    active_tiles.clear();
+  }
+
+  if (!workers.empty())
+    SyncCarriedState();
+
+  triangles.clear();
+  triangles_area = 0;
+
+  for (auto& context : contexts)
+  {
+    ADDSTAT(g_stats.this_frame.rasterized_pixels, context->rasterized_pixels);
+    context->rasterized_pixels = 0;
+    context->tev.FlushCounters();
+  }
+}
 }  // namespace Rasterizer
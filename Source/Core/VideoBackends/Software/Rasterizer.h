@@ -10,6 +10,7 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
@@ -17,6 +18,10 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
 
+// Draws the triangles passed to DrawTriangleFrontFace since the last call, possibly on several
+// threads. This must be called before any state that the triangles depend on changes.
+void Flush();
+
 void SetTevKonstColors();
 
 struct RasterBlockPixel
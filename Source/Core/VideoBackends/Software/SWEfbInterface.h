@@ -56,7 +56,8 @@ void EncodeXFB(u8* xfb_in_ram, u32 memory_stride, const MathUtil::Rectangle<int>
 
 u32 GetPerfQueryResult(PerfQueryType type);
 void ResetPerfQuery();
-void IncPerfCounterQuadCount(PerfQueryType type);
+// counts pixel_count pixels that reached the stage of the pipeline measured by type
+void IncPerfCounterQuadCount(PerfQueryType type, u32 pixel_count);
 }  // namespace EfbInterface
 
 namespace SW
@@ -31,14 +31,14 @@ static inline s16 Clamp1024(s16 in)
   return std::clamp<s16>(in, -1024, 1023);
 }
 
-void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
+void Tev::SetRasColor(const StageSetup& stage)
 {
-  switch (colorChan)
+  switch (stage.ras_color)
   {
   case RasColorChan::Color0:
   {
     const u8* color = Color[0];
-    const auto& swap = bpmem.tevksel.GetSwapTable(swaptable);
+    const auto& swap = stage.ras_swap;
     RasColor.r = color[u32(swap[ColorChannel::Red])];
     RasColor.g = color[u32(swap[ColorChannel::Green])];
     RasColor.b = color[u32(swap[ColorChannel::Blue])];
@@ -48,7 +48,7 @@ void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
   case RasColorChan::Color1:
   {
     const u8* color = Color[1];
-    const auto& swap = bpmem.tevksel.GetSwapTable(swaptable);
+    const auto& swap = stage.ras_swap;
     RasColor.r = color[u32(swap[ColorChannel::Red])];
     RasColor.g = color[u32(swap[ColorChannel::Green])];
     RasColor.b = color[u32(swap[ColorChannel::Blue])];
@@ -68,8 +68,8 @@ void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
   break;
   default:
   {
-    if (colorChan != RasColorChan::Zero)
-      PanicAlertFmt("Invalid ras color channel: {}", colorChan);
+    if (stage.ras_color != RasColorChan::Zero)
+      PanicAlertFmt("Invalid ras color channel: {}", stage.ras_color);
 
     RasColor = TevColor::All(0);
   }
@@ -77,27 +77,6 @@ void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
   }
 }
 
-void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
-{
-  for (int i = BLU_C; i <= RED_C; i++)
-  {
-    const InputRegType& InputReg = inputs[i];
-
-    const u16 c = InputReg.c + (InputReg.c >> 7);
-
-    s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-    temp <<= s_ScaleLShiftLUT[cc.scale];
-    temp += (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
-    temp >>= 8;
-    temp = cc.op == TevOp::Sub ? -temp : temp;
-
-    s32 result = ((InputReg.d + s_BiasLUT[cc.bias]) << s_ScaleLShiftLUT[cc.scale]) + temp;
-    result = result >> s_ScaleRShiftLUT[cc.scale];
-
-    Reg[cc.dest][i] = result;
-  }
-}
-
 void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
 {
   for (int i = BLU_C; i <= RED_C; i++)
@@ -137,23 +116,6 @@ void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const Inpu
   }
 }
 
-void Tev::DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
-{
-  const InputRegType& InputReg = inputs[ALP_C];
-
-  const u16 c = InputReg.c + (InputReg.c >> 7);
-
-  s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
-  temp <<= s_ScaleLShiftLUT[ac.scale];
-  temp += (ac.scale == TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128;
-  temp = ac.op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
-
-  s32 result = ((InputReg.d + s_BiasLUT[ac.bias]) << s_ScaleLShiftLUT[ac.scale]) + temp;
-  result = result >> s_ScaleRShiftLUT[ac.scale];
-
-  Reg[ac.dest].a = result;
-}
-
 void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
 {
   u32 a, b;
@@ -384,71 +346,52 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
   }
 }
 
-void Tev::Draw()
+template <bool HasIndirect, bool HasZTex, bool HasFog>
+void Tev::DrawPixel()
 {
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  ++m_pixels_in;
 
-  auto& system = Core::System::GetInstance();
-  auto& pixel_shader_manager = system.GetPixelShaderManager();
+  const Pipeline& pipeline = *m_pipeline;
 
   // initial color values
   for (int i = 0; i < 4; i++)
-  {
-    Reg[static_cast<TevOutput>(i)].r = pixel_shader_manager.constants.colors[i][0];
-    Reg[static_cast<TevOutput>(i)].g = pixel_shader_manager.constants.colors[i][1];
-    Reg[static_cast<TevOutput>(i)].b = pixel_shader_manager.constants.colors[i][2];
-    Reg[static_cast<TevOutput>(i)].a = pixel_shader_manager.constants.colors[i][3];
-  }
+    Reg[static_cast<TevOutput>(i)] = pipeline.initial_colors[i];
 
-  for (unsigned int stageNum = 0; stageNum < bpmem.genMode.numindstages; stageNum++)
+  if constexpr (HasIndirect)
   {
-    const int stageNum2 = stageNum >> 1;
-    const int stageOdd = stageNum & 1;
-
-    u32 texcoordSel = bpmem.tevindref.getTexCoord(stageNum);
-    const u32 texmap = bpmem.tevindref.getTexMap(stageNum);
-
-    // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
-    // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
-    // This affects the Mario portrait in Luigi's Mansion, where the developers forgot to set
-    // the number of tex gens to 2 (bug 11462).
-    if (texcoordSel >= bpmem.genMode.numtexgens)
-      texcoordSel = 0;
-
-    const TEXSCALE& texscale = bpmem.texscale[stageNum2];
-    const s32 scaleS = stageOdd ? texscale.ss1 : texscale.ss0;
-    const s32 scaleT = stageOdd ? texscale.ts1 : texscale.ts0;
-
-    TextureSampler::Sample(Uv[texcoordSel].s >> scaleS, Uv[texcoordSel].t >> scaleT,
-                           IndirectLod[stageNum], IndirectLinear[stageNum], texmap,
-                           IndirectTex[stageNum]);
+    for (unsigned int stageNum = 0; stageNum < pipeline.num_indirect_stages; stageNum++)
+    {
+      const IndirectStageSetup& stage = pipeline.indirect_stages[stageNum];
+      TextureSampler::Sample(Uv[stage.texcoord].s >> stage.scale_s,
+                             Uv[stage.texcoord].t >> stage.scale_t, IndirectLod[stageNum],
+                             IndirectLinear[stageNum], stage.texmap, IndirectTex[stageNum]);
+    }
   }
 
-  for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
+  for (unsigned int stageNum = 0; stageNum < pipeline.num_stages; stageNum++)
   {
-    const int stageNum2 = stageNum >> 1;
-    const int stageOdd = stageNum & 1;
-    const TwoTevStageOrders& order = bpmem.tevorders[stageNum2];
+    const StageSetup& stage = pipeline.stages[stageNum];
 
     // stage combiners
-    const TevStageCombiner::ColorCombiner& cc = bpmem.combiners[stageNum].colorC;
-    const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[stageNum].alphaC;
+    const TevStageCombiner::ColorCombiner& cc = stage.combiner.cc;
+    const TevStageCombiner::AlphaCombiner& ac = stage.combiner.ac;
 
-    u32 texcoordSel = order.getTexCoord(stageOdd);
-    const u32 texmap = order.getTexMap(stageOdd);
-
-    // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
-    // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
-    if (texcoordSel >= bpmem.genMode.numtexgens)
-      texcoordSel = 0;
-
-    Indirect(stageNum, Uv[texcoordSel].s, Uv[texcoordSel].t);
+    if (HasIndirect && stage.indirect)
+    {
+      Indirect(stageNum, Uv[stage.texcoord].s, Uv[stage.texcoord].t);
+    }
+    else
+    {
+      TexCoord.s = Uv[stage.texcoord].s;
+      TexCoord.t = Uv[stage.texcoord].t;
+      AlphaBump = 0;
+    }
 
     // sample texture
-    if (order.getEnable(stageOdd))
+    if (stage.texture_enable)
     {
       // RGBA
       u8 texel[4];
@@ -456,7 +399,7 @@ void Tev::Draw()
       if (bpmem.genMode.numtexgens > 0)
       {
         TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum],
-                               TextureLinear[stageNum], texmap, texel);
+                               TextureLinear[stageNum], stage.texmap, texel);
       }
       else
       {
@@ -470,7 +413,7 @@ void Tev::Draw()
       RawTexColor.b = texel[u32(ColorChannel::Blue)];
       RawTexColor.a = texel[u32(ColorChannel::Alpha)];
 
-      const auto& swap = bpmem.tevksel.GetSwapTable(ac.tswap);
+      const auto& swap = stage.texture_swap;
       TexColor.r = texel[u32(swap[ColorChannel::Red])];
       TexColor.g = texel[u32(swap[ColorChannel::Green])];
       TexColor.b = texel[u32(swap[ColorChannel::Blue])];
@@ -478,77 +421,92 @@ void Tev::Draw()
     }
 
     // set konst for this stage
-    const auto kc = bpmem.tevksel.GetKonstColor(stageNum);
-    const auto ka = bpmem.tevksel.GetKonstAlpha(stageNum);
-    StageKonst.r = m_KonstLUT[kc].r;
-    StageKonst.g = m_KonstLUT[kc].g;
-    StageKonst.b = m_KonstLUT[kc].b;
-    StageKonst.a = m_KonstLUT[ka].a;
+    StageKonst.r = m_KonstLUT[stage.konst_color].r;
+    StageKonst.g = m_KonstLUT[stage.konst_color].g;
+    StageKonst.b = m_KonstLUT[stage.konst_color].b;
+    StageKonst.a = m_KonstLUT[stage.konst_alpha].a;
 
     // set color
-    SetRasColor(order.getColorChan(stageOdd), ac.rswap);
+    SetRasColor(stage);
 
     // combine inputs
-    InputRegType inputs[4];
-    inputs[BLU_C].a = m_ColorInputLUT[cc.a].b;
-    inputs[BLU_C].b = m_ColorInputLUT[cc.b].b;
-    inputs[BLU_C].c = m_ColorInputLUT[cc.c].b;
-    inputs[BLU_C].d = m_ColorInputLUT[cc.d].b;
-    inputs[GRN_C].a = m_ColorInputLUT[cc.a].g;
-    inputs[GRN_C].b = m_ColorInputLUT[cc.b].g;
-    inputs[GRN_C].c = m_ColorInputLUT[cc.c].g;
-    inputs[GRN_C].d = m_ColorInputLUT[cc.d].g;
-    inputs[RED_C].a = m_ColorInputLUT[cc.a].r;
-    inputs[RED_C].b = m_ColorInputLUT[cc.b].r;
-    inputs[RED_C].c = m_ColorInputLUT[cc.c].r;
-    inputs[RED_C].d = m_ColorInputLUT[cc.d].r;
-    inputs[ALP_C].a = m_AlphaInputLUT[ac.a].a;
-    inputs[ALP_C].b = m_AlphaInputLUT[ac.b].a;
-    inputs[ALP_C].c = m_AlphaInputLUT[ac.c].a;
-    inputs[ALP_C].d = m_AlphaInputLUT[ac.d].a;
+    const TevCombiner::Inputs inputs{
+        .a = {m_AlphaInputLUT[ac.a].a, m_ColorInputLUT[cc.a].b, m_ColorInputLUT[cc.a].g,
+              m_ColorInputLUT[cc.a].r},
+        .b = {m_AlphaInputLUT[ac.b].a, m_ColorInputLUT[cc.b].b, m_ColorInputLUT[cc.b].g,
+              m_ColorInputLUT[cc.b].r},
+        .c = {m_AlphaInputLUT[ac.c].a, m_ColorInputLUT[cc.c].b, m_ColorInputLUT[cc.c].g,
+              m_ColorInputLUT[cc.c].r},
+        .d = {m_AlphaInputLUT[ac.d].a, m_ColorInputLUT[cc.d].b, m_ColorInputLUT[cc.d].g,
+              m_ColorInputLUT[cc.d].r},
+    };
+
+    TevCombiner::Outputs outputs;
+    m_combine(stage.combiner, inputs, outputs);
+
+    // The comparison modes aren't handled by TevCombiner
+    InputRegType compare_inputs[4];
+    if (cc.bias == TevBias::Compare || ac.bias == TevBias::Compare)
+    {
+      for (int i = ALP_C; i <= RED_C; i++)
+      {
+        compare_inputs[i].a = inputs.a[i];
+        compare_inputs[i].b = inputs.b[i];
+        compare_inputs[i].c = inputs.c[i];
+        compare_inputs[i].d = inputs.d[i];
+      }
+    }
 
     if (cc.bias != TevBias::Compare)
-      DrawColorRegular(cc, inputs);
-    else
-      DrawColorCompare(cc, inputs);
-
-    if (cc.clamp)
     {
-      Reg[cc.dest].r = Clamp255(Reg[cc.dest].r);
-      Reg[cc.dest].g = Clamp255(Reg[cc.dest].g);
-      Reg[cc.dest].b = Clamp255(Reg[cc.dest].b);
+      Reg[cc.dest].r = outputs[RED_C];
+      Reg[cc.dest].g = outputs[GRN_C];
+      Reg[cc.dest].b = outputs[BLU_C];
     }
     else
     {
-      Reg[cc.dest].r = Clamp1024(Reg[cc.dest].r);
-      Reg[cc.dest].g = Clamp1024(Reg[cc.dest].g);
-      Reg[cc.dest].b = Clamp1024(Reg[cc.dest].b);
+      DrawColorCompare(cc, compare_inputs);
+
+      if (cc.clamp)
+      {
+        Reg[cc.dest].r = Clamp255(Reg[cc.dest].r);
+        Reg[cc.dest].g = Clamp255(Reg[cc.dest].g);
+        Reg[cc.dest].b = Clamp255(Reg[cc.dest].b);
+      }
+      else
+      {
+        Reg[cc.dest].r = Clamp1024(Reg[cc.dest].r);
+        Reg[cc.dest].g = Clamp1024(Reg[cc.dest].g);
+        Reg[cc.dest].b = Clamp1024(Reg[cc.dest].b);
+      }
     }
 
     if (ac.bias != TevBias::Compare)
-      DrawAlphaRegular(ac, inputs);
+    {
+      Reg[ac.dest].a = outputs[ALP_C];
+    }
     else
-      DrawAlphaCompare(ac, inputs);
+    {
+      DrawAlphaCompare(ac, compare_inputs);
 
-    if (ac.clamp)
-      Reg[ac.dest].a = Clamp255(Reg[ac.dest].a);
-    else
-      Reg[ac.dest].a = Clamp1024(Reg[ac.dest].a);
+      if (ac.clamp)
+        Reg[ac.dest].a = Clamp255(Reg[ac.dest].a);
+      else
+        Reg[ac.dest].a = Clamp1024(Reg[ac.dest].a);
+    }
   }
 
   // convert to 8 bits per component
-  // the results of the last tev stage are put onto the screen,
-  // regardless of the used destination register - TODO: Verify!
-  const auto& color_index = bpmem.combiners[bpmem.genMode.numtevstages].colorC.dest;
-  const auto& alpha_index = bpmem.combiners[bpmem.genMode.numtevstages].alphaC.dest;
+  const TevOutput color_index = pipeline.color_dest;
+  const TevOutput alpha_index = pipeline.alpha_dest;
   u8 output[4] = {(u8)Reg[alpha_index].a, (u8)Reg[color_index].b, (u8)Reg[color_index].g,
                   (u8)Reg[color_index].r};
 
-  if (!TevAlphaTest(output[ALP_C]))
+  if (!pipeline.alpha_test[output[ALP_C]])
     return;
 
   // z texture
-  if (bpmem.ztex2.op != ZTexOp::Disabled)
+  if constexpr (HasZTex)
   {
     u32 ztex = bpmem.ztex1.bias;
     switch (bpmem.ztex2.type)
@@ -573,7 +531,7 @@ void Tev::Draw()
   }
 
   // fog
-  if (bpmem.fog.c_proj_fsel.fsel != FogType::Off)
+  if constexpr (HasFog)
   {
     float ze;
 
@@ -660,28 +618,160 @@ void Tev::Draw()
     output[BLU_C] = (output[BLU_C] * invFog + fogInt * bpmem.fog.color.b) >> 8;
   }
 
-  if (bpmem.GetEmulatedZ() == EmulatedZ::Late)
+  if (pipeline.late_z)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  m_bbox_left = std::min(m_bbox_left, static_cast<u16>(Position[0] & ~1));
+  m_bbox_right = std::max(m_bbox_right, static_cast<u16>(Position[0] | 1));
+  m_bbox_top = std::min(m_bbox_top, static_cast<u16>(Position[1] & ~1));
+  m_bbox_bottom = std::max(m_bbox_bottom, static_cast<u16>(Position[1] | 1));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  ++m_pixels_out;
+  IncPerfCounterQuadCount(PQ_BLEND_INPUT);
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
 
+static bool ReadsTexColor(const TevStageCombiner::ColorCombiner& cc,
+                          const TevStageCombiner::AlphaCombiner& ac)
+{
+  const auto is_tex = [](TevColorArg arg) {
+    return arg == TevColorArg::TexColor || arg == TevColorArg::TexAlpha;
+  };
+  return is_tex(cc.a) || is_tex(cc.b) || is_tex(cc.c) || is_tex(cc.d) ||
+         ac.a == TevAlphaArg::TexAlpha || ac.b == TevAlphaArg::TexAlpha ||
+         ac.c == TevAlphaArg::TexAlpha || ac.d == TevAlphaArg::TexAlpha;
+}
+
+// Whether Indirect() leaves the texture coordinate of the previous stage (or pixel) in place, or
+// adds to it.
+static bool KeepsPreviousTexCoord(const TevStageIndirect& indirect)
+{
+  if (indirect.fb_addprev)
+    return true;
+  return indirect.matrix_index != IndMtxIndex::Off && indirect.matrix_id != IndMtxId::Indirect &&
+         indirect.matrix_id != IndMtxId::S && indirect.matrix_id != IndMtxId::T;
+}
+
+void Tev::SetupPipeline(Pipeline& pipeline)
+{
+  using DrawTable = std::array<std::array<std::array<DrawFunction, 2>, 2>, 2>;
+  static constexpr DrawTable draw_table = {{
+      {{{&Tev::DrawPixel<false, false, false>, &Tev::DrawPixel<false, false, true>},
+        {&Tev::DrawPixel<false, true, false>, &Tev::DrawPixel<false, true, true>}}},
+      {{{&Tev::DrawPixel<true, false, false>, &Tev::DrawPixel<true, false, true>},
+        {&Tev::DrawPixel<true, true, false>, &Tev::DrawPixel<true, true, true>}}},
+  }};
+
+  auto& system = Core::System::GetInstance();
+  auto& pixel_shader_manager = system.GetPixelShaderManager();
+
+  for (int i = 0; i < 4; i++)
+  {
+    pipeline.initial_colors[i] = TevColor(pixel_shader_manager.constants.colors[i][3],
+                                          pixel_shader_manager.constants.colors[i][2],
+                                          pixel_shader_manager.constants.colors[i][1],
+                                          pixel_shader_manager.constants.colors[i][0]);
+  }
+
+  // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
+  // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
+  // This affects the Mario portrait in Luigi's Mansion, where the developers forgot to set
+  // the number of tex gens to 2 (bug 11462).
+  const auto get_texcoord = [](u32 texcoord) {
+    return texcoord < bpmem.genMode.numtexgens ? texcoord : 0;
+  };
+
+  pipeline.used_texmaps = {};
+  pipeline.num_indirect_stages = bpmem.genMode.numindstages;
+  for (u32 stageNum = 0; stageNum < pipeline.num_indirect_stages; stageNum++)
+  {
+    const TEXSCALE& texscale = bpmem.texscale[stageNum >> 1];
+    const bool stageOdd = stageNum & 1;
+
+    IndirectStageSetup& stage = pipeline.indirect_stages[stageNum];
+    stage.texcoord = get_texcoord(bpmem.tevindref.getTexCoord(stageNum));
+    stage.texmap = bpmem.tevindref.getTexMap(stageNum);
+    stage.scale_s = stageOdd ? texscale.ss1 : texscale.ss0;
+    stage.scale_t = stageOdd ? texscale.ts1 : texscale.ts0;
+
+    pipeline.used_texmaps[stage.texmap] = true;
+  }
+
+  bool has_indirect = pipeline.num_indirect_stages != 0;
+  bool texture_sampled = false;
+  bool reads_unsampled_texture = false;
+  pipeline.num_stages = bpmem.genMode.numtevstages + 1;
+  for (u32 stageNum = 0; stageNum < pipeline.num_stages; stageNum++)
+  {
+    const TwoTevStageOrders& order = bpmem.tevorders[stageNum >> 1];
+    const int stageOdd = stageNum & 1;
+
+    StageSetup& stage = pipeline.stages[stageNum];
+    stage.combiner.Set(bpmem.combiners[stageNum].colorC, bpmem.combiners[stageNum].alphaC);
+    stage.texcoord = get_texcoord(order.getTexCoord(stageOdd));
+    stage.texmap = order.getTexMap(stageOdd);
+    stage.texture_enable = order.getEnable(stageOdd);
+    stage.indirect = bpmem.tevind[stageNum].hex != 0;
+    stage.konst_color = bpmem.tevksel.GetKonstColor(stageNum);
+    stage.konst_alpha = bpmem.tevksel.GetKonstAlpha(stageNum);
+    stage.ras_color = order.getColorChan(stageOdd);
+    stage.texture_swap = bpmem.tevksel.GetSwapTable(stage.combiner.ac.tswap);
+    stage.ras_swap = bpmem.tevksel.GetSwapTable(stage.combiner.ac.rswap);
+
+    has_indirect |= stage.indirect;
+    if (stage.texture_enable && bpmem.genMode.numtexgens > 0)
+      pipeline.used_texmaps[stage.texmap] = true;
+
+    if (stage.texture_enable)
+      texture_sampled = true;
+    else if (!texture_sampled && ReadsTexColor(stage.combiner.cc, stage.combiner.ac))
+      reads_unsampled_texture = true;
+  }
+
+  // A pixel starts out with the texture color and texture coordinate that the previous pixel left
+  // behind. Reading the texture color before any stage has sampled a texture only gives a value
+  // that differs between pixels if a later stage samples one, and only the first stage can pick up
+  // the previous pixel's texture coordinate, since every stage sets it.
+  pipeline.depends_on_previous_pixel =
+      (reads_unsampled_texture && texture_sampled) ||
+      (pipeline.stages[0].indirect && KeepsPreviousTexCoord(bpmem.tevind[0]));
+
+  // the results of the last tev stage are put onto the screen,
+  // regardless of the used destination register - TODO: Verify!
+  pipeline.color_dest = bpmem.combiners[bpmem.genMode.numtevstages].colorC.dest;
+  pipeline.alpha_dest = bpmem.combiners[bpmem.genMode.numtevstages].alphaC.dest;
+
+  for (u32 alpha = 0; alpha < pipeline.alpha_test.size(); alpha++)
+    pipeline.alpha_test[alpha] = TevAlphaTest(alpha);
+
+  pipeline.late_z = bpmem.GetEmulatedZ() == EmulatedZ::Late;
+
+  const bool has_ztex = bpmem.ztex2.op != ZTexOp::Disabled;
+  const bool has_fog = bpmem.fog.c_proj_fsel.fsel != FogType::Off;
+  pipeline.draw = draw_table[has_indirect][has_ztex][has_fog];
+}
+
+void Tev::CopyCarriedState(const Tev& other)
+{
+  RawTexColor = other.RawTexColor;
+  TexColor = other.TexColor;
+  std::memcpy(IndirectTex, other.IndirectTex, sizeof(IndirectTex));
+  TexCoord = other.TexCoord;
+  std::memcpy(Color, other.Color, sizeof(Color));
+  std::memcpy(Uv, other.Uv, sizeof(Uv));
+}
+
 void Tev::SetKonstColors()
 {
   auto& system = Core::System::GetInstance();
@@ -695,3 +785,25 @@ void Tev::SetKonstColors()
     KonstantColors[i].a = pixel_shader_manager.constants.kcolors[i][3];
   }
 }
+
+void Tev::FlushCounters()
+{
+  for (u32 i = 0; i < PQ_NUM_MEMBERS; ++i)
+  {
+    if (m_perf_pixel_counts[i] != 0)
+      EfbInterface::IncPerfCounterQuadCount(static_cast<PerfQueryType>(i), m_perf_pixel_counts[i]);
+  }
+  m_perf_pixel_counts = {};
+
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, m_pixels_in);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, m_pixels_out);
+  m_pixels_in = 0;
+  m_pixels_out = 0;
+
+  if (m_bbox_left <= m_bbox_right)
+    BBoxManager::Update(m_bbox_left, m_bbox_right, m_bbox_top, m_bbox_bottom);
+  m_bbox_left = std::numeric_limits<u16>::max();
+  m_bbox_right = 0;
+  m_bbox_top = std::numeric_limits<u16>::max();
+  m_bbox_bottom = 0;
+}
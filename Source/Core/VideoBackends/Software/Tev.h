@@ -4,9 +4,13 @@
 #pragma once
 
 #include <array>
+#include <limits>
 
+#include "Common/BitSet.h"
 #include "Common/EnumMap.h"
+#include "VideoBackends/Software/TevCombiner.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -193,9 +197,34 @@ class Tev
       TevKonstRef::Value(KonstantColors[2].a),  // Konst 2 Alpha
       TevKonstRef::Value(KonstantColors[3].a),  // Konst 3 Alpha
   };
-  static constexpr Common::EnumMap<s16, TevBias::Compare> s_BiasLUT{0, 128, -128, 0};
-  static constexpr Common::EnumMap<u8, TevScale::Divide2> s_ScaleLShiftLUT{0, 1, 2, 0};
-  static constexpr Common::EnumMap<u8, TevScale::Divide2> s_ScaleRShiftLUT{0, 0, 0, 1};
+
+  // Evaluates the combiners that aren't in comparison mode
+  const TevCombiner::CombineFunction m_combine = TevCombiner::GetCombineFunction();
+
+  struct IndirectStageSetup
+  {
+    u32 texcoord;
+    u32 texmap;
+    s32 scale_s;
+    s32 scale_t;
+  };
+
+  struct StageSetup
+  {
+    TevCombiner::Params combiner;
+    u32 texcoord;
+    u32 texmap;
+    bool texture_enable;
+    // Stages without any indirect configuration use their texture coordinates unmodified
+    bool indirect;
+    KonstSel konst_color;
+    KonstSel konst_alpha;
+    RasColorChan ras_color;
+    Common::EnumMap<ColorChannel, ColorChannel::Alpha> texture_swap;
+    Common::EnumMap<ColorChannel, ColorChannel::Alpha> ras_swap;
+  };
+
+  using DrawFunction = void (Tev::*)();
 
   enum BufferBase
   {
@@ -204,16 +233,50 @@ class Tev
     INDIRECT = 32
   };
 
-  void SetRasColor(RasColorChan colorChan, u32 swaptable);
+  void SetRasColor(const StageSetup& stage);
 
-  void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
-  void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
   void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
+  template <bool HasIndirect, bool HasZTex, bool HasFog>
+  void DrawPixel();
+
+  // Pixel counts and the bounding box are gathered per Tev, since several threads may be drawing
+  // at once (see Rasterizer). FlushCounters() adds them to the global state.
+  std::array<u32, PQ_NUM_MEMBERS> m_perf_pixel_counts{};
+  u32 m_pixels_in = 0;
+  u32 m_pixels_out = 0;
+  u16 m_bbox_left = std::numeric_limits<u16>::max();
+  u16 m_bbox_right = 0;
+  u16 m_bbox_top = std::numeric_limits<u16>::max();
+  u16 m_bbox_bottom = 0;
+
 public:
+  // The parts of the TEV and pixel engine configuration that stay the same for a whole batch,
+  // decoded from bpmem once rather than for every pixel. It also selects a version of Draw() with
+  // the indirect texturing, z texture and fog code left out when the batch doesn't use them.
+  struct Pipeline
+  {
+    DrawFunction draw;
+    std::array<TevColor, 4> initial_colors;
+    u32 num_indirect_stages;
+    u32 num_stages;
+    std::array<IndirectStageSetup, 4> indirect_stages;
+    std::array<StageSetup, 16> stages;
+    TevOutput color_dest;
+    TevOutput alpha_dest;
+    // Result of the alpha test for each alpha value
+    std::array<bool, 256> alpha_test;
+    bool late_z;
+    // Whether a pixel can read a value that the previous pixel drawn in this batch has set, in
+    // which case the pixels have to be drawn in the order they were submitted.
+    bool depends_on_previous_pixel;
+    // The texmaps that the TEV stages and indirect stages sample
+    BitSet32 used_texmaps;
+  };
+
   s32 Position[3]{};
   u8 Color[2][4]{};  // must be RGBA for correct swap table ordering
   TextureCoordinateType Uv[8]{};
@@ -230,6 +293,19 @@ public:
     RED_C
   };
 
+  static void SetupPipeline(Pipeline& pipeline);
+  void SetPipeline(const Pipeline& pipeline) { m_pipeline = &pipeline; }
+
+  // Copies the values that outlive a pixel, because they're only set by some pixels or only by
+  // some stages, so that this Tev carries on from the last pixel that the other one drew.
+  void CopyCarriedState(const Tev& other);
+
   void SetKonstColors();
-  void Draw();
+  void Draw() { (this->*m_pipeline->draw)(); }
+
+  void IncPerfCounterQuadCount(PerfQueryType type) { ++m_perf_pixel_counts[type]; }
+  void FlushCounters();
+
+private:
+  const Pipeline* m_pipeline = nullptr;
 };
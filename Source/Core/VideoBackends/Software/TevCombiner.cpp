@@ -0,0 +1,196 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Software/TevCombiner.h"
+
+#include <algorithm>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/EnumMap.h"
+#include "Common/Intrinsics.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+namespace TevCombiner
+{
+namespace
+{
+enum
+{
+  ALP_C,
+  BLU_C,
+  GRN_C,
+  RED_C
+};
+
+constexpr Common::EnumMap<s16, TevBias::Compare> s_BiasLUT{0, 128, -128, 0};
+constexpr Common::EnumMap<u8, TevScale::Divide2> s_ScaleLShiftLUT{0, 1, 2, 0};
+constexpr Common::EnumMap<u8, TevScale::Divide2> s_ScaleRShiftLUT{0, 0, 0, 1};
+
+template <typename Combiner>
+void SetComponentParams(Params& params, int i, const Combiner& combiner, bool negate_before_shift)
+{
+  const bool subtract = combiner.op == TevOp::Sub;
+  params.scale[i] = 1 << s_ScaleLShiftLUT[combiner.scale];
+  params.divide[i] = s_ScaleRShiftLUT[combiner.scale] ? -1 : 0;
+  params.rounding[i] = combiner.scale == TevScale::Divide2 ? 0 : subtract ? 127 : 128;
+  params.negate_before[i] = subtract && negate_before_shift ? -1 : 0;
+  params.negate_after[i] = subtract && !negate_before_shift ? -1 : 0;
+  params.bias[i] = s_BiasLUT[combiner.bias];
+  params.min[i] = combiner.clamp ? 0 : -1024;
+  params.max[i] = combiner.clamp ? 255 : 1023;
+}
+
+#ifdef _M_X86_64
+FUNCTION_TARGET_SSR41 void CombineSSE41(const Params& params, const Inputs& inputs,
+                                        Outputs& outputs)
+{
+  const __m128i scale = _mm_load_si128(reinterpret_cast<const __m128i*>(params.scale));
+  const __m128i divide = _mm_load_si128(reinterpret_cast<const __m128i*>(params.divide));
+  const __m128i rounding = _mm_load_si128(reinterpret_cast<const __m128i*>(params.rounding));
+  const __m128i negate_before =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(params.negate_before));
+  const __m128i negate_after =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(params.negate_after));
+  const __m128i bias = _mm_load_si128(reinterpret_cast<const __m128i*>(params.bias));
+  const __m128i min = _mm_load_si128(reinterpret_cast<const __m128i*>(params.min));
+  const __m128i max = _mm_load_si128(reinterpret_cast<const __m128i*>(params.max));
+
+  const __m128i mask_8 = _mm_set1_epi32(0xFF);
+  const __m128i a = _mm_and_si128(
+      _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(inputs.a.data()))),
+      mask_8);
+  const __m128i b = _mm_and_si128(
+      _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(inputs.b.data()))),
+      mask_8);
+  __m128i c = _mm_and_si128(
+      _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(inputs.c.data()))),
+      mask_8);
+  c = _mm_add_epi32(c, _mm_srli_epi32(c, 7));
+  // Sign extend d from 11 bits
+  __m128i d =
+      _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(inputs.d.data())));
+  d = _mm_srai_epi32(_mm_slli_epi32(d, 21), 21);
+
+  // a * (256 - c) + b * c. All the factors fit into 16 bits, so PMADDWD can do this at once.
+  const __m128i ab = _mm_or_si128(a, _mm_slli_epi32(b, 16));
+  const __m128i weights =
+      _mm_or_si128(_mm_sub_epi32(_mm_set1_epi32(256), c), _mm_slli_epi32(c, 16));
+  __m128i temp = _mm_madd_epi16(ab, weights);
+  temp = _mm_mullo_epi32(temp, scale);
+  temp = _mm_add_epi32(temp, rounding);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_before), negate_before);
+  temp = _mm_srai_epi32(temp, 8);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_after), negate_after);
+
+  __m128i result = _mm_mullo_epi32(_mm_add_epi32(d, bias), scale);
+  result = _mm_add_epi32(result, temp);
+  result = _mm_blendv_epi8(result, _mm_srai_epi32(result, 1), divide);
+  result = _mm_max_epi32(result, min);
+  result = _mm_min_epi32(result, max);
+
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(outputs.data()), _mm_packs_epi32(result, result));
+}
+#endif
+
+#ifdef _M_ARM_64
+void CombineNEON(const Params& params, const Inputs& inputs, Outputs& outputs)
+{
+  const int32x4_t mask_8 = vdupq_n_s32(0xFF);
+  const int32x4_t a = vandq_s32(vmovl_s16(vld1_s16(inputs.a.data())), mask_8);
+  const int32x4_t b = vandq_s32(vmovl_s16(vld1_s16(inputs.b.data())), mask_8);
+  int32x4_t c = vandq_s32(vmovl_s16(vld1_s16(inputs.c.data())), mask_8);
+  c = vaddq_s32(c, vshrq_n_s32(c, 7));
+  // Sign extend d from 11 bits
+  const int32x4_t d = vshrq_n_s32(vshlq_n_s32(vmovl_s16(vld1_s16(inputs.d.data())), 21), 21);
+
+  const int32x4_t scale = vld1q_s32(params.scale);
+  const int32x4_t negate_before = vld1q_s32(params.negate_before);
+  const int32x4_t negate_after = vld1q_s32(params.negate_after);
+
+  int32x4_t temp = vmlaq_s32(vmulq_s32(a, vsubq_s32(vdupq_n_s32(256), c)), b, c);
+  temp = vmulq_s32(temp, scale);
+  temp = vaddq_s32(temp, vld1q_s32(params.rounding));
+  temp = vsubq_s32(veorq_s32(temp, negate_before), negate_before);
+  temp = vshrq_n_s32(temp, 8);
+  temp = vsubq_s32(veorq_s32(temp, negate_after), negate_after);
+
+  int32x4_t result = vmulq_s32(vaddq_s32(d, vld1q_s32(params.bias)), scale);
+  result = vaddq_s32(result, temp);
+  result = vbslq_s32(vreinterpretq_u32_s32(vld1q_s32(params.divide)), vshrq_n_s32(result, 1),
+                     result);
+  result = vmaxq_s32(result, vld1q_s32(params.min));
+  result = vminq_s32(result, vld1q_s32(params.max));
+
+  vst1_s16(outputs.data(), vmovn_s32(result));
+}
+#endif
+}  // namespace
+
+void Params::Set(const TevStageCombiner::ColorCombiner& cc_,
+                 const TevStageCombiner::AlphaCombiner& ac_)
+{
+  cc.hex = cc_.hex;
+  ac.hex = ac_.hex;
+
+  // The alpha combiner negates the lerp before shifting it right, while the color combiner
+  // negates it afterwards, so they round differently.
+  SetComponentParams(*this, ALP_C, ac, true);
+  for (int i = BLU_C; i <= RED_C; i++)
+    SetComponentParams(*this, i, cc, false);
+}
+
+void CombineScalar(const Params& params, const Inputs& inputs, Outputs& outputs)
+{
+  const TevStageCombiner::ColorCombiner& cc = params.cc;
+  const TevStageCombiner::AlphaCombiner& ac = params.ac;
+
+  for (int i = BLU_C; i <= RED_C; i++)
+  {
+    const u8 a = static_cast<u8>(inputs.a[i]);
+    const u8 b = static_cast<u8>(inputs.b[i]);
+    const u16 c = static_cast<u8>(inputs.c[i]) + (static_cast<u8>(inputs.c[i]) >> 7);
+    const s32 d = static_cast<s16>(inputs.d[i] << 5) >> 5;
+
+    s32 temp = a * (256 - c) + (b * c);
+    temp <<= s_ScaleLShiftLUT[cc.scale];
+    temp += (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
+    temp >>= 8;
+    temp = cc.op == TevOp::Sub ? -temp : temp;
+
+    s32 result = ((d + s_BiasLUT[cc.bias]) << s_ScaleLShiftLUT[cc.scale]) + temp;
+    result = result >> s_ScaleRShiftLUT[cc.scale];
+
+    outputs[i] = cc.clamp ? std::clamp(result, 0, 255) : std::clamp(result, -1024, 1023);
+  }
+
+  const u8 a = static_cast<u8>(inputs.a[ALP_C]);
+  const u8 b = static_cast<u8>(inputs.b[ALP_C]);
+  const u16 c = static_cast<u8>(inputs.c[ALP_C]) + (static_cast<u8>(inputs.c[ALP_C]) >> 7);
+  const s32 d = static_cast<s16>(inputs.d[ALP_C] << 5) >> 5;
+
+  s32 temp = a * (256 - c) + (b * c);
+  temp <<= s_ScaleLShiftLUT[ac.scale];
+  temp += (ac.scale == TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128;
+  temp = ac.op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
+
+  s32 result = ((d + s_BiasLUT[ac.bias]) << s_ScaleLShiftLUT[ac.scale]) + temp;
+  result = result >> s_ScaleRShiftLUT[ac.scale];
+
+  outputs[ALP_C] = ac.clamp ? std::clamp(result, 0, 255) : std::clamp(result, -1024, 1023);
+}
+
+CombineFunction GetCombineFunction()
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+    return CombineSSE41;
+#elif defined(_M_ARM_64)
+  return CombineNEON;
+#endif
+  return CombineScalar;
+}
+}  // namespace TevCombiner
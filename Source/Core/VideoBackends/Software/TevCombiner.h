@@ -0,0 +1,62 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BPMemory.h"
+
+// The arithmetic of the TEV stage combiners in regular (not compare) mode, which is evaluated for
+// all four components of a pixel at once where the host supports it.
+namespace TevCombiner
+{
+// The inputs of a TEV stage for one pixel. Components are in Tev's order (alpha, blue, green,
+// red). Like on hardware, only the low 8 bits of a, b and c and the low 11 bits of d are used.
+struct Inputs
+{
+  std::array<s16, 4> a;
+  std::array<s16, 4> b;
+  std::array<s16, 4> c;
+  std::array<s16, 4> d;
+};
+
+// The clamped results of the color combiner (blue, green and red) and of the alpha combiner.
+using Outputs = std::array<s16, 4>;
+
+// The combiners of a TEV stage, along with how they treat each component, which the vectorized
+// implementations need. Setting these up takes longer than combining, so Tev does it once per
+// batch for each stage.
+struct alignas(16) Params
+{
+  Params() = default;
+  Params(const TevStageCombiner::ColorCombiner& cc_, const TevStageCombiner::AlphaCombiner& ac_)
+  {
+    Set(cc_, ac_);
+  }
+
+  void Set(const TevStageCombiner::ColorCombiner& cc_, const TevStageCombiner::AlphaCombiner& ac_);
+
+  s32 scale[4];
+  s32 divide[4];
+  s32 rounding[4];
+  s32 negate_before[4];
+  s32 negate_after[4];
+  s32 bias[4];
+  s32 min[4];
+  s32 max[4];
+
+  TevStageCombiner::ColorCombiner cc;
+  TevStageCombiner::AlphaCombiner ac;
+};
+
+using CombineFunction = void (*)(const Params& params, const Inputs& inputs, Outputs& outputs);
+
+// The results are only meaningful for the combiners whose bias isn't TevBias::Compare.
+void CombineScalar(const Params& params, const Inputs& inputs, Outputs& outputs);
+
+// Returns the fastest implementation for the host CPU, which gives the same results as
+// CombineScalar.
+CombineFunction GetCombineFunction();
+}  // namespace TevCombiner
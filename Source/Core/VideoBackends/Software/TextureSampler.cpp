@@ -4,9 +4,16 @@
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <map>
 #include <span>
+#include <vector>
 
+#include "Common/Align.h"
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Common/SpanUtils.h"
 #include "Core/HW/Memmap.h"
@@ -15,10 +22,70 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureDecoder.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 #define ALLOW_MIPMAP 1
 
 namespace TextureSampler
 {
+namespace
+{
+// Where the texels of a mip level are read from
+struct LevelSource
+{
+  std::span<const u8> image_src;
+  std::span<const u8> image_src_odd;
+  int width_minus_1;
+  int height_minus_1;
+};
+
+struct DecodedLevel
+{
+  int width;
+  int height;
+  // Four bytes per texel as written by TexDecoder_DecodeTexel, row by row
+  std::vector<u8> texels;
+};
+
+struct DecodedTextureKey
+{
+  // Main memory address, or TMEM line if from_tmem is set
+  u32 image_base;
+  u32 tmem_odd;
+  bool from_tmem;
+  TextureFormat format;
+  u32 width_minus_1;
+  u32 height_minus_1;
+  u32 tlut_address;
+  TLUTFormat tlut_format;
+  u32 num_levels;
+
+  auto operator<=>(const DecodedTextureKey&) const = default;
+};
+
+struct DecodedTexture
+{
+  // Hash of the encoded levels and the palette that the texture was decoded from
+  u64 hash = 0;
+  u64 last_used = 0;
+  std::vector<DecodedLevel> levels;
+};
+}  // namespace
+
+// Once the decoded textures take up more than this, the ones that the current batch doesn't use
+// are dropped.
+constexpr size_t MAX_DECODED_SIZE = 256 * 1024 * 1024;
+
+static std::map<DecodedTextureKey, DecodedTexture> s_decoded_textures;
+static size_t s_decoded_size = 0;
+static u64 s_batch_count = 0;
+
+// The textures of the current batch by texmap. These are only written on the GPU thread between
+// batches, so the rasterizer threads can read them without synchronization.
+static std::array<const DecodedTexture*, 8> s_bound_textures{};
+
 static inline void WrapCoord(int* coordp, WrapMode wrap_mode, int image_size)
 {
   int coord = *coordp;
@@ -114,23 +181,17 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
   }
 }
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
+static LevelSource GetLevelSource(const TexUnit& texUnit, s32 mip)
 {
-  auto texUnit = bpmem.tex.GetUnit(texmap);
-
-  const TexMode0& tm0 = texUnit.texMode0;
   const TexImage0& ti0 = texUnit.texImage0;
-  const TexTLUT& texTlut = texUnit.texTlut;
   const TextureFormat texfmt = ti0.format;
-  const TLUTFormat tlutfmt = texTlut.tlut_format;
 
-  std::span<const u8> image_src;
-  std::span<const u8> image_src_odd;
+  LevelSource level;
   if (texUnit.texImage1.cache_manually_managed)
   {
-    image_src = TexDecoder_GetTmemSpan(texUnit.texImage1.tmem_even * TMEM_LINE_SIZE);
+    level.image_src = TexDecoder_GetTmemSpan(texUnit.texImage1.tmem_even * TMEM_LINE_SIZE);
     if (texfmt == TextureFormat::RGBA8)
-      image_src_odd = TexDecoder_GetTmemSpan(texUnit.texImage2.tmem_odd * TMEM_LINE_SIZE);
+      level.image_src_odd = TexDecoder_GetTmemSpan(texUnit.texImage2.tmem_odd * TMEM_LINE_SIZE);
   }
   else
   {
@@ -138,30 +199,25 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     auto& memory = system.GetMemory();
 
     const u32 imageBase = texUnit.texImage3.image_base << 5;
-    image_src = memory.GetSpanForAddress(imageBase);
+    level.image_src = memory.GetSpanForAddress(imageBase);
   }
 
-  int image_width_minus_1 = ti0.width;
-  int image_height_minus_1 = ti0.height;
+  level.width_minus_1 = ti0.width;
+  level.height_minus_1 = ti0.height;
 
-  const int tlutAddress = texTlut.tmem_offset << 9;
-  const std::span<const u8> tlut = TexDecoder_GetTmemSpan(tlutAddress);
-
-  // reduce sample location and texture size to mip level
+  // reduce texture size to mip level
   // move texture pointer to mip location
   if (mip)
   {
-    int mipWidth = image_width_minus_1 + 1;
-    int mipHeight = image_height_minus_1 + 1;
+    int mipWidth = level.width_minus_1 + 1;
+    int mipHeight = level.height_minus_1 + 1;
 
     const int fmtWidth = TexDecoder_GetBlockWidthInTexels(texfmt);
     const int fmtHeight = TexDecoder_GetBlockHeightInTexels(texfmt);
     const int fmtDepth = TexDecoder_GetTexelSizeInNibbles(texfmt);
 
-    image_width_minus_1 >>= mip;
-    image_height_minus_1 >>= mip;
-    s >>= mip;
-    t >>= mip;
+    level.width_minus_1 >>= mip;
+    level.height_minus_1 >>= mip;
 
     while (mip)
     {
@@ -169,13 +225,285 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
       mipHeight = std::max(mipHeight, fmtHeight);
       const u32 size = (mipWidth * mipHeight * fmtDepth) >> 1;
 
-      image_src = Common::SafeSubspan(image_src, size);
+      level.image_src = Common::SafeSubspan(level.image_src, size);
       mipWidth >>= 1;
       mipHeight >>= 1;
       mip--;
     }
   }
 
+  return level;
+}
+
+static u64 HashSpan(std::span<const u8> span, u32 size)
+{
+  size = std::min<u32>(size, static_cast<u32>(span.size()));
+  return size != 0 ? Common::GetHash64(span.data(), size, 0) : 0;
+}
+
+static u64 HashTexture(const TexUnit& texUnit, const DecodedTextureKey& key,
+                       std::span<const u8> tlut)
+{
+  const u32 block_width = TexDecoder_GetBlockWidthInTexels(key.format);
+  const u32 block_height = TexDecoder_GetBlockHeightInTexels(key.format);
+
+  u64 hash = HashSpan(tlut, TexDecoder_GetPaletteSize(key.format));
+  for (u32 mip = 0; mip < key.num_levels; mip++)
+  {
+    // TexDecoder_DecodeTexel reads whole blocks
+    const LevelSource level = GetLevelSource(texUnit, mip);
+    const u32 width = Common::AlignUp(static_cast<u32>(level.width_minus_1) + 1, block_width);
+    const u32 height = Common::AlignUp(static_cast<u32>(level.height_minus_1) + 1, block_height);
+    const u32 size = TexDecoder_GetTextureSizeInBytes(width, height, key.format);
+
+    hash = hash * 31 + HashSpan(level.image_src, size);
+    hash = hash * 31 + HashSpan(level.image_src_odd, size);
+  }
+  return hash;
+}
+
+static DecodedLevel DecodeLevel(const TexUnit& texUnit, const LevelSource& source,
+                                std::span<const u8> tlut)
+{
+  const TextureFormat texfmt = texUnit.texImage0.format;
+  const TLUTFormat tlutfmt = texUnit.texTlut.tlut_format;
+  const bool rgba8_from_tmem =
+      texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed;
+
+  DecodedLevel level;
+  level.width = source.width_minus_1 + 1;
+  level.height = source.height_minus_1 + 1;
+  level.texels.resize(level.width * level.height * 4);
+
+  u8* texel = level.texels.data();
+  for (int t = 0; t < level.height; t++)
+  {
+    for (int s = 0; s < level.width; s++, texel += 4)
+    {
+      if (!rgba8_from_tmem)
+      {
+        TexDecoder_DecodeTexel(texel, source.image_src, s, t, source.width_minus_1, texfmt, tlut,
+                               tlutfmt);
+      }
+      else
+      {
+        TexDecoder_DecodeTexelRGBA8FromTmem(texel, source.image_src, source.image_src_odd, s, t,
+                                            source.width_minus_1);
+      }
+    }
+  }
+
+  return level;
+}
+
+void BindTextures(BitSet32 used_texmaps)
+{
+  s_batch_count++;
+  s_bound_textures.fill(nullptr);
+
+  for (const int texmap : used_texmaps)
+  {
+    const TexUnit& texUnit = bpmem.tex.GetUnit(texmap);
+    const TexMode0& tm0 = texUnit.texMode0;
+    const TexMode1& tm1 = texUnit.texMode1;
+    const TexTLUT& texTlut = texUnit.texTlut;
+
+    DecodedTextureKey key{};
+    key.from_tmem = texUnit.texImage1.cache_manually_managed;
+    key.image_base = key.from_tmem ? texUnit.texImage1.tmem_even.Value() :
+                                     texUnit.texImage3.image_base.Value();
+    key.tmem_odd = key.from_tmem ? texUnit.texImage2.tmem_odd.Value() : 0;
+    key.format = texUnit.texImage0.format;
+    key.width_minus_1 = texUnit.texImage0.width;
+    key.height_minus_1 = texUnit.texImage0.height;
+    key.tlut_address = texTlut.tmem_offset;
+    key.tlut_format = texTlut.tlut_format;
+
+    // The LOD is clamped to max_lod unless min_lod is larger, and the level after it may be blended
+    // in or rounded up to.
+    key.num_levels = 1;
+    if (tm0.mipmap_filter != MipMode::None)
+      key.num_levels = ((std::max(tm1.min_lod.Value(), tm1.max_lod.Value()) + 15) >> 4) + 1;
+
+    const std::span<const u8> tlut = TexDecoder_GetTmemSpan(texTlut.tmem_offset << 9);
+    const u64 hash = HashTexture(texUnit, key, tlut);
+
+    auto [it, inserted] = s_decoded_textures.try_emplace(key);
+    DecodedTexture& texture = it->second;
+    if (inserted || texture.hash != hash)
+    {
+      for (const DecodedLevel& level : texture.levels)
+        s_decoded_size -= level.texels.size();
+      texture.levels.clear();
+
+      for (u32 mip = 0; mip < key.num_levels; mip++)
+      {
+        const DecodedLevel& level =
+            texture.levels.emplace_back(DecodeLevel(texUnit, GetLevelSource(texUnit, mip), tlut));
+        s_decoded_size += level.texels.size();
+      }
+      texture.hash = hash;
+    }
+
+    texture.last_used = s_batch_count;
+    s_bound_textures[texmap] = &texture;
+  }
+
+  if (s_decoded_size > MAX_DECODED_SIZE)
+  {
+    for (auto it = s_decoded_textures.begin(); it != s_decoded_textures.end();)
+    {
+      if (it->second.last_used == s_batch_count)
+      {
+        ++it;
+        continue;
+      }
+
+      for (const DecodedLevel& level : it->second.levels)
+        s_decoded_size -= level.texels.size();
+      it = s_decoded_textures.erase(it);
+    }
+  }
+}
+
+void ClearCache()
+{
+  s_bound_textures.fill(nullptr);
+  s_decoded_textures.clear();
+  s_decoded_size = 0;
+}
+
+static void BilinearFilter(const u8* texel00, const u8* texel10, const u8* texel01,
+                           const u8* texel11, u32 fractS, u32 fractT, u8* sample)
+{
+  // The weights sum up to 128 * 128, and all fit into 16 bits.
+  const u32 weight00 = (128 - fractS) * (128 - fractT);
+  const u32 weight10 = fractS * (128 - fractT);
+  const u32 weight01 = (128 - fractS) * fractT;
+  const u32 weight11 = fractS * fractT;
+
+#if defined(_M_X86_64)
+  const auto load = [](const u8* texel) {
+    u32 value;
+    std::memcpy(&value, texel, sizeof(u32));
+    return _mm_cvtsi32_si128(value);
+  };
+
+  // Interleave the components of two texels, so that PMADDWD weights and adds them at once.
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i top = _mm_unpacklo_epi8(_mm_unpacklo_epi8(load(texel00), load(texel10)), zero);
+  const __m128i bottom = _mm_unpacklo_epi8(_mm_unpacklo_epi8(load(texel01), load(texel11)), zero);
+  __m128i result = _mm_add_epi32(_mm_madd_epi16(top, _mm_set1_epi32(weight10 << 16 | weight00)),
+                                 _mm_madd_epi16(bottom, _mm_set1_epi32(weight11 << 16 | weight01)));
+  result = _mm_srli_epi32(result, 14);
+  result = _mm_packus_epi16(_mm_packs_epi32(result, result), result);
+
+  const u32 value = _mm_cvtsi128_si32(result);
+  std::memcpy(sample, &value, sizeof(u32));
+#elif defined(_M_ARM_64)
+  const auto load = [](const u8* texel) {
+    u32 value;
+    std::memcpy(&value, texel, sizeof(u32));
+    return vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(value))));
+  };
+
+  uint32x4_t result = vmull_n_u16(load(texel00), weight00);
+  result = vmlal_n_u16(result, load(texel10), weight10);
+  result = vmlal_n_u16(result, load(texel01), weight01);
+  result = vmlal_n_u16(result, load(texel11), weight11);
+  const uint16x4_t narrow = vshrn_n_u32(result, 14);
+
+  const u32 value = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(narrow, narrow))), 0);
+  std::memcpy(sample, &value, sizeof(u32));
+#else
+  for (int i = 0; i < 4; i++)
+  {
+    sample[i] = static_cast<u8>((texel00[i] * weight00 + texel10[i] * weight10 +
+                                 texel01[i] * weight01 + texel11[i] * weight11) >>
+                                14);
+  }
+#endif
+}
+
+static void SampleDecodedLevel(s32 s, s32 t, bool linear, const TexMode0& tm0,
+                               const DecodedLevel& level, u8* sample)
+{
+  const auto get_texel = [&level](int imageS, int imageT) {
+    return &level.texels[(imageT * level.width + imageS) * 4];
+  };
+
+  if (linear)
+  {
+    // offset linear sampling
+    s -= 64;
+    t -= 64;
+
+    // integer part of sample location
+    int imageS = s >> 7;
+    int imageT = t >> 7;
+
+    // linear sampling
+    int imageSPlus1 = imageS + 1;
+    const int fractS = s & 0x7f;
+
+    int imageTPlus1 = imageT + 1;
+    const int fractT = t & 0x7f;
+
+    WrapCoord(&imageS, tm0.wrap_s, level.width);
+    WrapCoord(&imageT, tm0.wrap_t, level.height);
+    WrapCoord(&imageSPlus1, tm0.wrap_s, level.width);
+    WrapCoord(&imageTPlus1, tm0.wrap_t, level.height);
+
+    BilinearFilter(get_texel(imageS, imageT), get_texel(imageSPlus1, imageT),
+                   get_texel(imageS, imageTPlus1), get_texel(imageSPlus1, imageTPlus1), fractS,
+                   fractT, sample);
+  }
+  else
+  {
+    // integer part of sample location
+    int imageS = s >> 7;
+    int imageT = t >> 7;
+
+    // nearest neighbor sampling
+    WrapCoord(&imageS, tm0.wrap_s, level.width);
+    WrapCoord(&imageT, tm0.wrap_t, level.height);
+
+    std::memcpy(sample, get_texel(imageS, imageT), 4);
+  }
+}
+
+void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
+{
+  auto texUnit = bpmem.tex.GetUnit(texmap);
+
+  const TexMode0& tm0 = texUnit.texMode0;
+
+  // reduce sample location to mip level
+  s >>= mip;
+  t >>= mip;
+
+  const DecodedTexture* const texture = s_bound_textures[texmap];
+  if (texture != nullptr && mip < static_cast<s32>(texture->levels.size())) [[likely]]
+  {
+    SampleDecodedLevel(s, t, linear, tm0, texture->levels[mip], sample);
+    return;
+  }
+
+  // Decode the texels directly, for textures that weren't bound for the current batch
+  const TexImage0& ti0 = texUnit.texImage0;
+  const TexTLUT& texTlut = texUnit.texTlut;
+  const TextureFormat texfmt = ti0.format;
+  const TLUTFormat tlutfmt = texTlut.tlut_format;
+
+  const LevelSource level = GetLevelSource(texUnit, mip);
+  const std::span<const u8> image_src = level.image_src;
+  const std::span<const u8> image_src_odd = level.image_src_odd;
+  const int image_width_minus_1 = level.width_minus_1;
+  const int image_height_minus_1 = level.height_minus_1;
+
+  const int tlutAddress = texTlut.tmem_offset << 9;
+  const std::span<const u8> tlut = TexDecoder_GetTmemSpan(tlutAddress);
+
   if (linear)
   {
     // offset linear sampling
@@ -3,10 +3,17 @@
 
 #pragma once
 
+#include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 
 namespace TextureSampler
 {
+// Decodes the levels of the textures in used_texmaps that the next batch may sample, unless the
+// data they are decoded from hasn't changed since they were last decoded. Must be called before
+// the batch is drawn, and not while it's being drawn.
+void BindTextures(BitSet32 used_texmaps);
+void ClearCache();
+
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
 
 void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
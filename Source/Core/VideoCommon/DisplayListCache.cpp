@@ -0,0 +1,115 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/DisplayListCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace DisplayListCache
+{
+// Limit for the converted vertices of all display lists together
+constexpr size_t MAX_CACHED_BYTES = 64 * 1024 * 1024;
+// The SSE vertex loader can write up to 4 bytes past the end
+constexpr size_t LOADER_OVERWRITE_BYTES = 4;
+
+static std::unordered_map<u64, DisplayList> s_display_lists;
+static size_t s_cached_bytes = 0;
+static std::vector<u8> s_scratch;
+
+static void DropVertices(DisplayList& display_list)
+{
+  for (const ConvertedVertices& primitive : display_list.primitives)
+    s_cached_bytes -= primitive.data.size();
+  display_list.primitives.clear();
+}
+
+DisplayList* Lookup(u32 address, const u8* data, u32 size)
+{
+  if (!g_ActiveConfig.bDisplayListCache)
+  {
+    if (!s_display_lists.empty())
+      Clear();
+    return nullptr;
+  }
+
+  // Start over rather than keeping track of which display lists are still in use, since most of
+  // them will be called again soon anyway.
+  if (s_cached_bytes > MAX_CACHED_BYTES)
+    Clear();
+
+  // Checking the contents on every call is what catches the game writing to the display list.
+  const u64 hash = Common::GetHash64(data, size, 0);
+  DisplayList& display_list = s_display_lists[(static_cast<u64>(address) << 32) | size];
+  if (display_list.hash != hash)
+  {
+    DropVertices(display_list);
+    display_list.hash = hash;
+  }
+  return &display_list;
+}
+
+ConvertedVertices& GetPrimitive(DisplayList& display_list, u32 index, u32 offset)
+{
+  if (index >= display_list.primitives.size())
+    display_list.primitives.resize(index + 1);
+
+  // A different offset means that a command in the display list changed the vertex format, so
+  // this isn't the same primitive command anymore.
+  ConvertedVertices& primitive = display_list.primitives[index];
+  if (primitive.offset != offset)
+  {
+    s_cached_bytes -= primitive.data.size();
+    primitive = {};
+    primitive.offset = offset;
+  }
+  return primitive;
+}
+
+int RunVertices(ConvertedVertices& cached, VertexLoaderBase* loader, const u8* src, u8* dst,
+                int count)
+{
+  // Converting the last three vertices again leaves the position and normal caches of
+  // VertexLoaderManager the same as converting all of them would.
+  const int tail = std::min(count, 3);
+  const int head = count - tail;
+  const size_t stride = loader->m_native_vtx_decl.stride;
+
+  if (cached.loader == loader && cached.count == count)
+  {
+    std::memcpy(dst, cached.data.data(), head * stride);
+    const u8* const tail_src = src + head * loader->m_vertex_size;
+    return head + loader->RunVertices(tail_src, dst + head * stride, tail);
+  }
+
+  // Indexed attributes depend on the vertex arrays rather than on the display list, and the loader
+  // may skip vertices with indexed positions.
+  if (loader->HasIndexedAttributes() || s_cached_bytes + head * stride > MAX_CACHED_BYTES)
+    return loader->RunVertices(src, dst, count);
+
+  // Convert into memory of our own, since reading back from the vertex buffer may be slow.
+  s_scratch.resize(count * stride + LOADER_OVERWRITE_BYTES);
+  const int num_loaded = loader->RunVertices(src, s_scratch.data(), count);
+  std::memcpy(dst, s_scratch.data(), num_loaded * stride);
+
+  s_cached_bytes -= cached.data.size();
+  cached.loader = loader;
+  cached.count = count;
+  cached.data.assign(s_scratch.begin(), s_scratch.begin() + head * stride);
+  s_cached_bytes += cached.data.size();
+
+  return num_loaded;
+}
+
+void Clear()
+{
+  s_display_lists.clear();
+  s_cached_bytes = 0;
+}
+}  // namespace DisplayListCache
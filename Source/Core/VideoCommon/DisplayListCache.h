@@ -0,0 +1,53 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class VertexLoaderBase;
+
+// Games tend to call the same static display lists every frame, so the vertices that the vertex
+// loaders convert from them can be kept around and copied instead of being converted again.
+//
+// A display list is looked up by its address and size, and the cached vertices are dropped as soon
+// as the hash of its contents changes. Only vertices without indexed attributes are cached, since
+// those don't depend on the vertex arrays, and the vertices of a primitive command are only reused
+// if it still goes through the same vertex loader.
+namespace DisplayListCache
+{
+// The vertices of one primitive command in a display list, as converted by a vertex loader.
+struct ConvertedVertices
+{
+  // Offset of the vertex data from the start of the display list
+  u32 offset = 0;
+  const VertexLoaderBase* loader = nullptr;
+  int count = 0;
+  // All but the last three vertices, which always go through the loader again.
+  std::vector<u8> data;
+};
+
+struct DisplayList
+{
+  u64 hash = 0;
+  // In the order that the primitive commands are run
+  std::vector<ConvertedVertices> primitives;
+};
+
+// Returns the cache entry for the display list at address, whose contents are data, or nullptr if
+// the cache is disabled. The entry stays valid until the next call.
+DisplayList* Lookup(u32 address, const u8* data, u32 size);
+
+// Returns the slot for the index-th primitive command of a display list, whose vertex data starts
+// at offset.
+ConvertedVertices& GetPrimitive(DisplayList& display_list, u32 index, u32 offset);
+
+// Converts count vertices from src into dst like loader->RunVertices, copying the results of the
+// previous conversion of the same primitive command where possible.
+int RunVertices(ConvertedVertices& cached, VertexLoaderBase* loader, const u8* src, u8* dst,
+                int count);
+
+void Clear();
+}  // namespace DisplayListCache
@@ -1113,6 +1113,25 @@ void FramebufferManager::DoState(PointerWrap& p)
     DoLoadState(p);
 }
 
+std::size_t FramebufferManager::EstimateStateSize() const
+{
+  if (!Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE))
+    return 0;
+
+  // Resolving doesn't change the dimensions, so this matches the configs used by DoSaveState().
+  const TextureConfig color_texture_config(
+      m_efb_color_texture->GetWidth(), m_efb_color_texture->GetHeight(),
+      m_efb_color_texture->GetLevels(), m_efb_color_texture->GetLayers(), 1, GetEFBColorFormat(),
+      0, AbstractTextureType::Texture_2DArray);
+  const TextureConfig depth_texture_config(
+      m_efb_depth_texture->GetWidth(), m_efb_depth_texture->GetHeight(),
+      m_efb_depth_texture->GetLevels(), m_efb_depth_texture->GetLayers(), 1,
+      GetEFBDepthCopyFormat(), 0, AbstractTextureType::Texture_2DArray);
+
+  return TextureCacheBase::GetSerializedTextureSize(color_texture_config) +
+         TextureCacheBase::GetSerializedTextureSize(depth_texture_config);
+}
+
 void FramebufferManager::DoSaveState(PointerWrap& p)
 {
   // For multisampling, we need to resolve first before we can save.
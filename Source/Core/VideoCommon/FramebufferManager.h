@@ -130,6 +130,8 @@ public:
 
   // Save state load/save.
   void DoState(PointerWrap& p);
+  // Approximate size of the data written by DoState().
+  std::size_t EstimateStateSize() const;
 
 protected:
   struct EFBPokeVertex
@@ -23,6 +23,7 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/DisplayListCache.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
@@ -129,8 +130,15 @@ public:
     // load vertices
     const u32 size = vertex_size * num_vertices;
 
-    const u32 bytes =
-        VertexLoaderManager::RunVertices<is_preprocess>(vat, primitive, num_vertices, vertex_data);
+    DisplayListCache::ConvertedVertices* cached = nullptr;
+    if (m_display_list != nullptr)
+    {
+      cached = &DisplayListCache::GetPrimitive(*m_display_list, m_display_list_primitive++,
+                                               vertex_data - m_display_list_start);
+    }
+
+    const u32 bytes = VertexLoaderManager::RunVertices<is_preprocess>(vat, primitive, num_vertices,
+                                                                      vertex_data, cached);
 
     ASSERT(bytes == size);
 
@@ -187,9 +195,15 @@ public:
           // temporarily swap dl and non-dl (small "hack" for the stats)
           g_stats.SwapDL();
 
+          m_display_list = DisplayListCache::Lookup(address, start_address, size);
+          m_display_list_start = start_address;
+          m_display_list_primitive = 0;
+
           Run(start_address, size, *this);
           INCSTAT(g_stats.this_frame.num_dlists_called);
 
+          m_display_list = nullptr;
+
           // un-swap
           g_stats.SwapDL();
         }
@@ -254,6 +268,11 @@ public:
 
   u32 m_cycles = 0;
   bool m_in_display_list = false;
+
+  // The display list that is being run, if the display list cache is enabled
+  DisplayListCache::DisplayList* m_display_list = nullptr;
+  const u8* m_display_list_start = nullptr;
+  u32 m_display_list_primitive = 0;
 };
 
 template <bool is_preprocess>
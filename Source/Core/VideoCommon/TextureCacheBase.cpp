@@ -8,6 +8,7 @@
 #include <cmath>
 #include <cstring>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -439,6 +440,30 @@ bool TextureCacheBase::CheckReadbackTexture(u32 width, u32 height, AbstractTextu
   return m_readback_texture != nullptr;
 }
 
+static u32 GetTextureDataSize(const TextureConfig& config)
+{
+  u32 total_size = 0;
+  for (u32 layer = 0; layer < config.layers; layer++)
+  {
+    for (u32 level = 0; level < config.levels; level++)
+    {
+      u32 level_width = std::max(config.width >> level, 1u);
+      u32 level_height = std::max(config.height >> level, 1u);
+
+      u32 stride = AbstractTexture::CalculateStrideForFormat(config.format, level_width);
+      u32 size = stride * level_height;
+
+      total_size += size;
+    }
+  }
+  return total_size;
+}
+
+std::size_t TextureCacheBase::GetSerializedTextureSize(const TextureConfig& config)
+{
+  return sizeof(TextureConfig) + sizeof(u32) + GetTextureDataSize(config);
+}
+
 void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfig& config,
                                         PointerWrap& p)
 {
@@ -449,20 +474,7 @@ void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfi
   if (skip_readback || CheckReadbackTexture(config.width, config.height, config.format))
   {
     // First, measure the amount of memory needed.
-    u32 total_size = 0;
-    for (u32 layer = 0; layer < config.layers; layer++)
-    {
-      for (u32 level = 0; level < config.levels; level++)
-      {
-        u32 level_width = std::max(config.width >> level, 1u);
-        u32 level_height = std::max(config.height >> level, 1u);
-
-        u32 stride = AbstractTexture::CalculateStrideForFormat(config.format, level_width);
-        u32 size = stride * level_height;
-
-        total_size += size;
-      }
-    }
+    u32 total_size = GetTextureDataSize(config);
 
     // Set aside total_size bytes of space for the textures.
     // When measuring, this will be set aside and not written to,
@@ -559,6 +571,44 @@ void TextureCacheBase::DoState(PointerWrap& p)
     DoLoadState(p);
 }
 
+static bool ShouldSaveEntry(const RcTcacheEntry& entry)
+{
+  // We skip non-copies as they can be decoded from RAM when the state is loaded.
+  // Storing them would duplicate data in the save state file, adding to decompression time.
+  // We also need to store invalidated entries, as they can't be restored from RAM.
+  return entry->IsCopy() || entry->invalidated;
+}
+
+std::size_t TextureCacheBase::EstimateStateSize() const
+{
+  if (!Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE))
+    return 0;
+
+  // Roughly what TCacheEntry::DoState writes.
+  constexpr std::size_t ENTRY_STATE_SIZE = 64;
+
+  // Entries are often referenced several times, but only serialized once.
+  std::set<const TCacheEntry*> entries;
+  std::size_t size = 0;
+  const auto AddEntry = [&entries, &size](const RcTcacheEntry& entry, std::size_t key_size) {
+    if (!entry || !ShouldSaveEntry(entry))
+      return;
+
+    size += key_size + sizeof(u32);
+    if (entries.insert(entry.get()).second)
+      size += GetSerializedTextureSize(entry->texture->GetConfig()) + ENTRY_STATE_SIZE;
+  };
+
+  for (const auto& [address, entry] : m_textures_by_address)
+    AddEntry(entry, sizeof(address));
+  for (const auto& [hash, entry] : m_textures_by_hash)
+    AddEntry(entry, sizeof(hash));
+  for (const RcTcacheEntry& entry : m_bound_textures)
+    AddEntry(entry, sizeof(u32));
+
+  return size;
+}
+
 void TextureCacheBase::DoSaveState(PointerWrap& p)
 {
   // Flush all stale binds
@@ -566,12 +616,6 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
 
   std::map<const TCacheEntry*, u32> entry_map;
   std::vector<TCacheEntry*> entries_to_save;
-  auto ShouldSaveEntry = [](const RcTcacheEntry& entry) {
-    // We skip non-copies as they can be decoded from RAM when the state is loaded.
-    // Storing them would duplicate data in the save state file, adding to decompression time.
-    // We also need to store invalidated entries, as they can't be restored from RAM.
-    return entry->IsCopy() || entry->invalidated;
-  };
   auto AddCacheEntryToMap = [&entry_map, &entries_to_save](const RcTcacheEntry& entry) -> u32 {
     auto iter = entry_map.find(entry.get());
     if (iter != entry_map.end())
@@ -302,9 +302,13 @@ public:
   // Texture Serialization
   void SerializeTexture(AbstractTexture* tex, const TextureConfig& config, PointerWrap& p);
   std::optional<TexPoolEntry> DeserializeTexture(PointerWrap& p);
+  // Number of bytes SerializeTexture() writes for a texture with the given config.
+  static std::size_t GetSerializedTextureSize(const TextureConfig& config);
 
   // Save States
   void DoState(PointerWrap& p);
+  // Approximate size of the data written by DoState().
+  std::size_t EstimateStateSize() const;
 
   static bool AllCopyFilterCoefsNeeded(const std::array<u32, 3>& coefficients);
   static bool CopyFilterCanOverflow(const std::array<u32, 3>& coefficients);
@@ -232,6 +232,23 @@ u32 VertexLoaderBase::GetVertexComponents(const TVtxDesc& vtx_desc, const VAT& v
   return components;
 }
 
+bool VertexLoaderBase::HasIndexedAttributes() const
+{
+  if (IsIndexed(m_VtxDesc.low.Position) || IsIndexed(m_VtxDesc.low.Normal))
+    return true;
+  for (u32 i = 0; i < m_VtxDesc.low.Color.Size(); i++)
+  {
+    if (IsIndexed(m_VtxDesc.low.Color[i]))
+      return true;
+  }
+  for (u32 i = 0; i < m_VtxDesc.high.TexCoord.Size(); i++)
+  {
+    if (IsIndexed(m_VtxDesc.high.TexCoord[i]))
+      return true;
+  }
+  return false;
+}
+
 std::unique_ptr<VertexLoaderBase> VertexLoaderBase::CreateVertexLoader(const TVtxDesc& vtx_desc,
                                                                        const VAT& vtx_attr)
 {
@@ -62,6 +62,9 @@ public:
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(const u8* src, u8* dst, int count) = 0;
 
+  // Whether any attribute is read from the vertex arrays rather than from the vertex itself
+  bool HasIndexedAttributes() const;
+
   // per loader public state
   PortableVertexDeclaration m_native_vtx_decl{};
   const u32 m_vertex_size;  // number of bytes of a raw GC vertex
@@ -25,6 +25,7 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/DisplayListCache.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
@@ -72,6 +73,8 @@ void Init()
 void Clear()
 {
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  // The display list cache refers to the loaders
+  DisplayListCache::Clear();
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
 }
@@ -396,7 +399,8 @@ static bool CanSplit(OpcodeDecoder::Primitive primitive)
 }
 
 template <bool IsPreprocess>
-int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src)
+int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src,
+                DisplayListCache::ConvertedVertices* cached)
 {
   if (count == 0) [[unlikely]]
     return 0;
@@ -448,11 +452,16 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     {
       const int max_vertices = 16380;  // Max is 16383, but 16380 is divisible by both 4 and 3
       const int run = CanSplit(primitive) && count > max_vertices ? max_vertices : count;
+      // Only whole primitive commands are cached
+      if (run != count)
+        cached = nullptr;
       count -= run;
       DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, run, stride,
                                                                   cullall || can_cpu_cull);
 
-      const int num_loaded = loader->RunVertices(src, dst.GetPointer(), run);
+      const int num_loaded =
+          cached ? DisplayListCache::RunVertices(*cached, loader, src, dst.GetPointer(), run) :
+                   loader->RunVertices(src, dst.GetPointer(), run);
       src += loader->m_vertex_size * max_vertices;
 
       if (can_cpu_cull && !cullall)
@@ -479,9 +488,9 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
 }
 
 template int RunVertices<false>(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count,
-                                const u8* src);
+                                const u8* src, DisplayListCache::ConvertedVertices* cached);
 template int RunVertices<true>(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count,
-                               const u8* src);
+                               const u8* src, DisplayListCache::ConvertedVertices* cached);
 
 NativeVertexFormat* GetCurrentVertexFormat()
 {
@@ -15,6 +15,11 @@
 class NativeVertexFormat;
 struct PortableVertexDeclaration;
 
+namespace DisplayListCache
+{
+struct ConvertedVertices;
+}
+
 namespace OpcodeDecoder
 {
 enum class Primitive : u8;
@@ -40,9 +45,11 @@ NativeVertexFormat* GetOrCreateMatchingFormat(const PortableVertexDeclaration& d
 // offsets set to the unused attributes.
 NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl);
 
-// Returns -1 if buf_size is insufficient, else the amount of bytes consumed
+// Returns -1 if buf_size is insufficient, else the amount of bytes consumed.
+// If cached is given, the vertices are converted through the display list cache.
 template <bool IsPreprocess = false>
-int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src);
+int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src,
+                DisplayListCache::ConvertedVertices* cached = nullptr);
 
 namespace detail
 {
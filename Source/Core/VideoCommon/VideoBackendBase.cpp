@@ -286,6 +286,20 @@ void VideoBackendBase::DoState(PointerWrap& p)
   system.GetFifo().GpuMaySleep();
 }
 
+std::size_t VideoBackendBase::EstimateStateSize()
+{
+  const auto EstimateSize = [] {
+    return g_framebuffer_manager->EstimateStateSize() + g_texture_cache->EstimateStateSize();
+  };
+
+  if (!Core::System::GetInstance().IsDualCoreMode())
+    return EstimateSize();
+
+  std::size_t size = 0;
+  AsyncRequests::GetInstance()->PushBlockingEvent([&] { size = EstimateSize(); });
+  return size;
+}
+
 bool VideoBackendBase::InitializeShared(std::unique_ptr<AbstractGfx> gfx,
                                         std::unique_ptr<VertexManagerBase> vertex_manager,
                                         std::unique_ptr<PerfQueryBase> perf_query,
@@ -63,6 +63,8 @@ public:
 
   // Wrapper function which pushes the event to the GPU thread.
   void DoState(PointerWrap& p);
+  // Approximate size of the parts of the state written by DoState() that can change in size.
+  std::size_t EstimateStateSize();
 
 protected:
   // For hardware backends
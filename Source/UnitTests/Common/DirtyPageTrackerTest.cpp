@@ -0,0 +1,134 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/DirtyPageTracker.h"
+#include "Common/MemArena.h"
+
+namespace
+{
+constexpr std::size_t TRACKED_PAGE_SIZE = Common::DirtyPageTracker::TRACKED_PAGE_SIZE;
+
+std::vector<std::size_t> GetSetIndices(const std::vector<bool>& bits)
+{
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0; i < bits.size(); ++i)
+  {
+    if (bits[i])
+      indices.push_back(i);
+  }
+  return indices;
+}
+}  // namespace
+
+TEST(DirtyPageTracker, MultipleViews)
+{
+  Common::DirtyPageTracker tracker;
+  if (!tracker.IsAvailable())
+    GTEST_SKIP() << "Dirty page tracking is unavailable on this host";
+
+  constexpr std::size_t page_count = 16;
+  constexpr std::size_t size = page_count * TRACKED_PAGE_SIZE;
+
+  Common::MemArena arena;
+  arena.GrabSHMSegment(size, "dolphin-dirty-page-test");
+  u8* const view_a = static_cast<u8*>(arena.CreateView(0, size));
+  u8* const view_b = static_cast<u8*>(arena.CreateView(0, size));
+  ASSERT_NE(view_a, nullptr);
+  ASSERT_NE(view_b, nullptr);
+  std::memset(view_a, 0, size);
+
+  ASSERT_TRUE(tracker.Reset());
+  view_a[3 * TRACKED_PAGE_SIZE + 1] = 1;
+  view_b[7 * TRACKED_PAGE_SIZE] = 2;
+
+  // Each view only knows about the writes made through it.
+  std::vector<bool> dirty_a(page_count), dirty_b(page_count);
+  ASSERT_TRUE(tracker.GetDirtyPages(view_a, size, dirty_a, 0));
+  ASSERT_TRUE(tracker.GetDirtyPages(view_b, size, dirty_b, 0));
+  EXPECT_EQ(GetSetIndices(dirty_a), std::vector<std::size_t>{3});
+  EXPECT_EQ(GetSetIndices(dirty_b), std::vector<std::size_t>{7});
+
+  // Results are written at the requested offset.
+  std::vector<bool> dirty(page_count * 2);
+  ASSERT_TRUE(tracker.GetDirtyPages(view_b, size, dirty, page_count));
+  EXPECT_EQ(GetSetIndices(dirty), std::vector<std::size_t>{page_count + 7});
+
+  // Reading the contents doesn't count as a write.
+  ASSERT_TRUE(tracker.Reset());
+  EXPECT_EQ(view_a[3 * TRACKED_PAGE_SIZE + 1], 1);
+  std::vector<bool> clean(page_count);
+  ASSERT_TRUE(tracker.GetDirtyPages(view_a, size, clean, 0));
+  ASSERT_TRUE(tracker.GetDirtyPages(view_b, size, clean, 0));
+  EXPECT_TRUE(GetSetIndices(clean).empty());
+
+  arena.ReleaseView(view_a, size);
+  arena.ReleaseView(view_b, size);
+  arena.ReleaseSHMSegment();
+}
+
+TEST(DirtyPageTracker, IncrementalSaveLatency)
+{
+  Common::DirtyPageTracker tracker;
+  if (!tracker.IsAvailable())
+    GTEST_SKIP() << "Dirty page tracking is unavailable on this host";
+
+  // MEM1 and MEM2 of a retail Wii.
+  constexpr std::size_t size = 0x01800000 + 0x04000000;
+  constexpr std::size_t page_count = size / TRACKED_PAGE_SIZE;
+
+  Common::MemArena arena;
+  arena.GrabSHMSegment(size, "dolphin-dirty-page-test");
+  u8* const memory = static_cast<u8*>(arena.CreateView(0, size));
+  ASSERT_NE(memory, nullptr);
+  std::memset(memory, 0, size);
+
+  std::vector<u8> snapshot(size);
+  const auto start_full = std::chrono::steady_clock::now();
+  std::memcpy(snapshot.data(), memory, size);
+  const auto end_full = std::chrono::steady_clock::now();
+
+  // A game typically writes a few megabytes of memory between two snapshots.
+  ASSERT_TRUE(tracker.Reset());
+  std::mt19937 rng(0);
+  for (std::size_t i = 0; i < page_count / 50; ++i)
+    memory[rng() % size] = static_cast<u8>(rng() | 1);
+
+  const auto start_incremental = std::chrono::steady_clock::now();
+  std::vector<bool> dirty(page_count);
+  ASSERT_TRUE(tracker.GetDirtyPages(memory, size, dirty, 0));
+  std::size_t dirty_page_count = 0;
+  for (std::size_t i = 0; i < page_count; ++i)
+  {
+    if (!dirty[i])
+      continue;
+
+    std::memcpy(snapshot.data() + i * TRACKED_PAGE_SIZE, memory + i * TRACKED_PAGE_SIZE,
+                TRACKED_PAGE_SIZE);
+    ++dirty_page_count;
+  }
+  ASSERT_TRUE(tracker.Reset());
+  const auto end_incremental = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(std::memcmp(snapshot.data(), memory, size), 0);
+  EXPECT_LE(dirty_page_count, page_count / 50);
+
+  // Reported in the test results rather than printed.
+  const auto to_us = [](auto duration) {
+    return std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+  };
+  RecordProperty("full_save_us", to_us(end_full - start_full));
+  RecordProperty("incremental_save_us", to_us(end_incremental - start_incremental));
+  RecordProperty("dirty_pages", std::to_string(dirty_page_count));
+
+  arena.ReleaseView(memory, size);
+  arena.ReleaseSHMSegment();
+}
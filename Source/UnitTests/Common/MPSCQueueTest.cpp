@@ -0,0 +1,131 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32, 16> q;
+
+  EXPECT_EQ(0u, q.Size());
+  EXPECT_TRUE(q.Empty());
+
+  q.Push(1);
+  EXPECT_EQ(1u, q.Size());
+  EXPECT_FALSE(q.Empty());
+
+  u32 v;
+  EXPECT_TRUE(q.Pop(v));
+  EXPECT_EQ(1u, v);
+  EXPECT_TRUE(q.Empty());
+  EXPECT_FALSE(q.Pop(v));
+
+  // Test the FIFO order across several laps of the ring.
+  for (u32 lap = 0; lap < 10; ++lap)
+  {
+    for (u32 i = 0; i < 16; ++i)
+      q.Push(i);
+    EXPECT_EQ(16u, q.Size());
+    for (u32 i = 0; i < 16; ++i)
+    {
+      u32 v2 = 0;
+      EXPECT_TRUE(q.Pop(v2));
+      EXPECT_EQ(i, v2);
+    }
+    EXPECT_TRUE(q.Empty());
+  }
+  EXPECT_EQ(0u, q.GetStats().overflows);
+}
+
+TEST(MPSCQueue, Overflow)
+{
+  Common::MPSCQueue<u32, 16> q;
+
+  // Elements that don't fit in the ring must still come out in order.
+  for (u32 i = 0; i < 100; ++i)
+    q.Push(i);
+  EXPECT_EQ(100u, q.Size());
+  EXPECT_EQ(84u, q.GetStats().overflows);
+
+  for (u32 i = 0; i < 50; ++i)
+  {
+    u32 v = 0;
+    EXPECT_TRUE(q.Pop(v));
+    EXPECT_EQ(i, v);
+  }
+
+  // While the overflow list is in use, new elements have to queue up behind it.
+  for (u32 i = 100; i < 110; ++i)
+    q.Push(i);
+  for (u32 i = 50; i < 110; ++i)
+  {
+    u32 v = 0;
+    EXPECT_TRUE(q.Pop(v));
+    EXPECT_EQ(i, v);
+  }
+  EXPECT_TRUE(q.Empty());
+
+  // Once it has been drained, the ring is used again.
+  q.Push(110);
+  u32 v = 0;
+  EXPECT_TRUE(q.Pop(v));
+  EXPECT_EQ(110u, v);
+  EXPECT_EQ(94u, q.GetStats().overflows);
+  EXPECT_EQ(84u, q.GetStats().max_depth);
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  static constexpr u32 NUM_PRODUCERS = 4;
+  static constexpr u32 NUM_ELEMENTS = 100000;
+
+  struct Element
+  {
+    u32 producer;
+    u32 index;
+  };
+
+  auto queue_ptr = std::make_unique<Common::MPSCQueue<Element, 64>>();
+  auto& q = *queue_ptr;
+
+  std::vector<std::thread> producers;
+  for (u32 producer = 0; producer < NUM_PRODUCERS; ++producer)
+  {
+    producers.emplace_back([&q, producer] {
+      for (u32 i = 0; i < NUM_ELEMENTS; ++i)
+        q.Push(Element{producer, i});
+    });
+  }
+
+  // Each producer's elements must be popped in the order they were pushed.
+  std::array<u32, NUM_PRODUCERS> next_index{};
+  u32 popped = 0;
+  while (popped < NUM_PRODUCERS * NUM_ELEMENTS)
+  {
+    Element element;
+    if (!q.Pop(element))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_LT(element.producer, NUM_PRODUCERS);
+    EXPECT_EQ(next_index[element.producer], element.index);
+    next_index[element.producer] = element.index + 1;
+    ++popped;
+  }
+
+  for (std::thread& producer : producers)
+    producer.join();
+
+  Element element;
+  EXPECT_FALSE(q.Pop(element));
+  EXPECT_TRUE(q.Empty());
+}
@@ -0,0 +1,114 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "Common/Event.h"
+#include "Common/PriorityWorkerPool.h"
+
+namespace
+{
+enum Priority
+{
+  HIGH,
+  NORMAL,
+  LOW,
+  PRIORITY_COUNT,
+};
+}  // namespace
+
+TEST(PriorityWorkerPool, Order)
+{
+  Common::PriorityWorkerPool<PRIORITY_COUNT> pool;
+
+  std::mutex order_mutex;
+  std::vector<int> order;
+  const auto record = [&](int value) {
+    return [&, value] {
+      std::lock_guard lk{order_mutex};
+      order.push_back(value);
+    };
+  };
+
+  // Nothing runs until there are workers, so everything below is queued at once.
+  pool.Push(LOW, record(5));
+  pool.Push(NORMAL, record(3));
+  pool.Push(LOW, record(6));
+  pool.Push(HIGH, record(1));
+  pool.Push(NORMAL, record(4));
+  pool.Push(HIGH, record(2));
+  pool.WaitForCompletion();
+  EXPECT_TRUE(order.empty());
+
+  pool.Reset("test worker", 1);
+  pool.WaitForCompletion();
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 4, 5, 6}));
+
+  pool.Shutdown();
+}
+
+TEST(PriorityWorkerPool, Cancel)
+{
+  Common::PriorityWorkerPool<PRIORITY_COUNT> pool("test worker", 1);
+
+  // Keep the only worker busy while the other functions are queued.
+  Common::Event started;
+  Common::Event release;
+  pool.Push(LOW, [&] {
+    started.Set();
+    release.Wait();
+  });
+  started.Wait();
+
+  std::atomic<int> high_runs = 0;
+  std::atomic<int> low_runs = 0;
+  for (int i = 0; i < 10; ++i)
+  {
+    pool.Push(HIGH, [&] { ++high_runs; });
+    pool.Push(LOW, [&] { ++low_runs; });
+  }
+  pool.Cancel(LOW);
+  release.Set();
+  pool.WaitForCompletion();
+
+  // Only the functions of the cancelled priority are dropped, and the one that had already started
+  // still ran to completion.
+  EXPECT_EQ(high_runs, 10);
+  EXPECT_EQ(low_runs, 0);
+
+  // The pool keeps working after a cancellation.
+  pool.Push(LOW, [&] { ++low_runs; });
+  pool.WaitForCompletion();
+  EXPECT_EQ(low_runs, 1);
+}
+
+TEST(PriorityWorkerPool, HighPriorityIsNotHeldUp)
+{
+  Common::PriorityWorkerPool<PRIORITY_COUNT> pool("test worker", 2);
+
+  // One worker is busy with a slow low priority function, and more lower priority work is waiting.
+  Common::Event started;
+  Common::Event release;
+  std::atomic<bool> lower_priority_started = false;
+  pool.Push(LOW, [&] {
+    started.Set();
+    release.Wait();
+  });
+  started.Wait();
+  pool.Push(LOW, [&] { lower_priority_started = true; });
+  pool.Push(NORMAL, [&] { lower_priority_started = true; });
+
+  // The last idle worker is kept for high priority work.
+  Common::Event high_done;
+  pool.Push(HIGH, [&] { high_done.Set(); });
+  high_done.Wait();
+  EXPECT_FALSE(lower_priority_started);
+
+  release.Set();
+  pool.WaitForCompletion();
+  EXPECT_TRUE(lower_priority_started);
+}
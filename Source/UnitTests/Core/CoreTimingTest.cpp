@@ -3,9 +3,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <string>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -393,3 +398,129 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(system, 4, MAX_SLICE_LENGTH);
 }
+
+TEST(CoreTiming, TimingWheelOrder)
+{
+  CoreTiming::TimingWheel wheel;
+  wheel.Reset(0);
+
+  // Spread events from the past to far in the future, so that every level of the wheel is used.
+  std::vector<CoreTiming::Event> expected;
+  u64 seed = 12345;
+  s64 now = 0;
+  u64 fifo_order = 0;
+  for (int round = 0; round < 100; ++round)
+  {
+    for (int i = 0; i < 100; ++i)
+    {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      const s64 distance = (static_cast<s64>(seed >> 2) >> (seed % 62)) - 1000;
+      const CoreTiming::Event event{now + distance, fifo_order++, seed, nullptr};
+      wheel.Insert(event);
+      expected.push_back(event);
+    }
+    std::ranges::sort(expected);
+
+    now += 50000;
+    CoreTiming::Event event;
+    while (wheel.PopDue(now, &event))
+    {
+      ASSERT_FALSE(expected.empty());
+      EXPECT_EQ(expected.front().time, event.time);
+      EXPECT_EQ(expected.front().fifo_order, event.fifo_order);
+      expected.erase(expected.begin());
+    }
+    ASSERT_EQ(expected.size(), wheel.Size());
+    if (!expected.empty())
+    {
+      EXPECT_LT(now, expected.front().time);
+      EXPECT_EQ(expected.front().time, wheel.GetNextTime());
+    }
+  }
+}
+
+namespace SchedulerThroughputTest
+{
+static constexpr u64 NUM_EVENT_TYPES = 64;
+static std::array<CoreTiming::EventType*, NUM_EVENT_TYPES> s_event_types;
+static std::array<s64, NUM_EVENT_TYPES> s_next_event_times;
+static std::array<u64, NUM_EVENT_TYPES> s_events_fired;
+static s64 s_last_event_time = 0;
+
+// Periods from tens to tens of thousands of cycles, like the SI/EXI/DSP/VI events.
+static s64 GetPeriod(u64 userdata)
+{
+  return 20 + static_cast<s64>((userdata * 7919) % 40000);
+}
+
+static void RescheduleCallback(Core::System& system, const u64 userdata, const s64 lateness)
+{
+  auto& core_timing = system.GetCoreTiming();
+  const s64 event_time = static_cast<s64>(core_timing.GetTicks()) - lateness;
+  EXPECT_EQ(s_next_event_times[userdata], event_time);
+  EXPECT_LE(s_last_event_time, event_time);
+  s_last_event_time = event_time;
+  ++s_events_fired[userdata];
+
+  s_next_event_times[userdata] = event_time + GetPeriod(userdata);
+  core_timing.ScheduleEvent(GetPeriod(userdata) - lateness, s_event_types[userdata], userdata);
+}
+}  // namespace SchedulerThroughputTest
+
+TEST(CoreTiming, SchedulerThroughput)
+{
+  using namespace SchedulerThroughputTest;
+
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  for (u64 i = 0; i < NUM_EVENT_TYPES; ++i)
+  {
+    s_event_types[i] =
+        core_timing.RegisterEvent(fmt::format("throughput{}", i), RescheduleCallback);
+  }
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  const s64 start_time = static_cast<s64>(core_timing.GetTicks());
+  for (u64 i = 0; i < NUM_EVENT_TYPES; ++i)
+  {
+    s_next_event_times[i] = start_time + static_cast<s64>(i);
+    core_timing.ScheduleEvent(static_cast<s64>(i), s_event_types[i], i);
+  }
+
+  s_events_fired = {};
+  s_last_event_time = 0;
+  constexpr int NUM_ADVANCES = 1000000;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_ADVANCES; ++i)
+  {
+    ppc_state.downcount = 0;
+    core_timing.Advance();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  // Events fire in order, so every event up to the last one that fired must have fired too.
+  u64 total_fired = 0;
+  for (u64 i = 0; i < NUM_EVENT_TYPES; ++i)
+  {
+    const s64 first_time = start_time + static_cast<s64>(i);
+    const u64 expected = s_last_event_time < first_time ?
+                             0 :
+                             static_cast<u64>((s_last_event_time - first_time) / GetPeriod(i)) + 1;
+    EXPECT_EQ(expected, s_events_fired[i]) << "event type " << i;
+    total_fired += s_events_fired[i];
+  }
+  EXPECT_GE(total_fired, static_cast<u64>(NUM_ADVANCES));
+
+  // Reported in the test results rather than printed.
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  testing::Test::RecordProperty("events_per_second",
+                                std::to_string(static_cast<u64>(total_fired / seconds)));
+}
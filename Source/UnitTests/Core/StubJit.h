@@ -23,6 +23,7 @@ public:
   void Jit(u32) override {}
   void EraseSingleBlock(const JitBlock&) override {}
   std::vector<MemoryStats> GetMemoryStats() const override { return {}; }
+  bool IsCodeSpaceLow() const override { return false; }
   std::size_t DisassembleNearCode(const JitBlock&, std::ostream&) const override { return 0; }
   std::size_t DisassembleFarCode(const JitBlock&, std::ostream&) const override { return 0; }
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
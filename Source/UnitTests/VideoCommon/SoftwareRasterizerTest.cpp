@@ -0,0 +1,136 @@
+// Copyright 2025 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/Rasterizer.h"
+#include "VideoBackends/Software/SWEfbInterface.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/VideoCommon.h"
+
+namespace
+{
+constexpr u32 BYTES_PER_PIXEL = 3;
+
+void SetUpBPMem(u32 num_color_channels, RasColorChan ras_color)
+{
+  std::memset(reinterpret_cast<u8*>(&bpmem), 0, sizeof(bpmem));
+
+  bpmem.genMode.numcolchans = num_color_channels;
+
+  bpmem.scissorBR.x = EFB_WIDTH - 1;
+  bpmem.scissorBR.y = EFB_HEIGHT - 1;
+
+  // A single stage that outputs the rasterized color
+  TevStageCombiner::ColorCombiner& cc = bpmem.combiners[0].colorC;
+  cc.a = TevColorArg::Zero;
+  cc.b = TevColorArg::Zero;
+  cc.c = TevColorArg::Zero;
+  cc.d = TevColorArg::RasColor;
+  TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[0].alphaC;
+  ac.a = TevAlphaArg::Zero;
+  ac.b = TevAlphaArg::Zero;
+  ac.c = TevAlphaArg::Zero;
+  ac.d = TevAlphaArg::RasAlpha;
+  bpmem.tevorders[0].colorchan_even = ras_color;
+
+  bpmem.alpha_test.comp0 = CompareMode::Always;
+  bpmem.alpha_test.comp1 = CompareMode::Always;
+
+  // Blending makes the result depend on the order in which triangles cover a pixel
+  bpmem.blendmode.blend_enable = true;
+  bpmem.blendmode.color_update = true;
+  bpmem.blendmode.src_factor = SrcBlendFactor::SrcAlpha;
+  bpmem.blendmode.dst_factor = DstBlendFactor::InvSrcAlpha;
+}
+
+void DrawRandomTriangles(std::mt19937& rng, int count)
+{
+  std::uniform_real_distribution<float> x_dist(-16.0f, EFB_WIDTH + 16.0f);
+  std::uniform_real_distribution<float> y_dist(-16.0f, EFB_HEIGHT + 16.0f);
+  std::uniform_int_distribution<int> color_dist(0, 255);
+
+  for (int i = 0; i < count; ++i)
+  {
+    OutputVertexData vertices[3];
+    for (OutputVertexData& vertex : vertices)
+    {
+      vertex.projectedPosition.w = 1.0f;
+      vertex.screenPosition = {x_dist(rng), y_dist(rng), 0.0f};
+      for (auto& channel : vertex.color)
+      {
+        for (u8& component : channel)
+          component = static_cast<u8>(color_dist(rng));
+      }
+    }
+
+    // Only front faces reach the rasterizer, so keep the winding consistent
+    const float cross = (vertices[1].screenPosition.x - vertices[0].screenPosition.x) *
+                            (vertices[2].screenPosition.y - vertices[0].screenPosition.y) -
+                        (vertices[1].screenPosition.y - vertices[0].screenPosition.y) *
+                            (vertices[2].screenPosition.x - vertices[0].screenPosition.x);
+    if (cross > 0.0f)
+      std::swap(vertices[1], vertices[2]);
+
+    Rasterizer::DrawTriangleFrontFace(&vertices[0], &vertices[1], &vertices[2]);
+  }
+}
+
+std::vector<u8> DrawBatches(int num_threads)
+{
+  Config::Init();
+  Config::SetCurrent(Config::GFX_SW_RASTERIZER_THREADS, num_threads);
+
+  for (u16 y = 0; y < EFB_HEIGHT; ++y)
+  {
+    for (u16 x = 0; x < EFB_WIDTH; ++x)
+      std::memset(EfbInterface::GetPixelPointer(x, y, false), 0, BYTES_PER_PIXEL);
+  }
+
+  Rasterizer::Init();
+  std::mt19937 rng(1234);
+
+  // Both color channels are written for every pixel drawn
+  SetUpBPMem(2, RasColorChan::Color0);
+  Rasterizer::ScissorChanged();
+  Rasterizer::SetTevKonstColors();
+  DrawRandomTriangles(rng, 64);
+  Rasterizer::Flush();
+
+  // The second color channel isn't rasterized, so it keeps the value of the pixel that was drawn
+  // last in the previous batch
+  SetUpBPMem(1, RasColorChan::Color1);
+  DrawRandomTriangles(rng, 64);
+  Rasterizer::Flush();
+
+  Rasterizer::Shutdown();
+  Config::Shutdown();
+
+  std::vector<u8> colors(EFB_WIDTH * EFB_HEIGHT * BYTES_PER_PIXEL);
+  for (u16 y = 0; y < EFB_HEIGHT; ++y)
+  {
+    for (u16 x = 0; x < EFB_WIDTH; ++x)
+    {
+      std::memcpy(&colors[(y * EFB_WIDTH + x) * BYTES_PER_PIXEL],
+                  EfbInterface::GetPixelPointer(x, y, false), BYTES_PER_PIXEL);
+    }
+  }
+  return colors;
+}
+}  // namespace
+
+TEST(SoftwareRasterizer, SameOutputForAnyThreadCount)
+{
+  const std::vector<u8> single_threaded = DrawBatches(1);
+  for (const int num_threads : {2, 4, 7})
+    EXPECT_EQ(DrawBatches(num_threads), single_threaded) << num_threads << " threads";
+}
@@ -1,6 +1,7 @@
 // Copyright 2014 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
 #include <bit>
 #include <limits>
 #include <memory>
@@ -12,6 +13,7 @@
 #include "Common/MathUtil.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/DisplayListCache.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -1062,6 +1064,58 @@ TEST_P(VertexLoaderSkippedTexCoordsTest, SkippedTextures)
   }
 }
 
+TEST_F(VertexLoaderTest, DisplayListCacheMatchesLoader)
+{
+  m_vtx_desc.low.PosMatIdx = true;
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::N;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Float;
+  CreateAndCheckSizes(1 + 6 * sizeof(float), 7 * sizeof(float));
+
+  constexpr int count = 10;
+  for (int i = 0; i < count; i++)
+  {
+    Input<u8>(i);
+    for (int j = 0; j < 6; j++)
+      Input<float>(i * 6 + j);
+  }
+
+  const auto clobber_caches = [] {
+    VertexLoaderManager::position_matrix_index_cache.fill(0xDEADBEEF);
+    VertexLoaderManager::position_cache = {};
+    VertexLoaderManager::normal_cache = {-1.f, -1.f, -1.f, -1.f};
+  };
+
+  const int stride = m_loader->m_native_vtx_decl.stride;
+  std::vector<u8> expected(count * stride + 4);
+  clobber_caches();
+  ASSERT_EQ(m_loader->RunVertices(input_memory, expected.data(), count), count);
+  const auto expected_matrix_indices = VertexLoaderManager::position_matrix_index_cache;
+  const auto expected_positions = VertexLoaderManager::position_cache;
+  const auto expected_normal = VertexLoaderManager::normal_cache;
+
+  // The first run converts the vertices and caches them, and the second one reuses them.
+  DisplayListCache::ConvertedVertices cached;
+  for (int run = 0; run < 2; run++)
+  {
+    std::vector<u8> actual(count * stride + 4);
+    clobber_caches();
+    ASSERT_EQ(DisplayListCache::RunVertices(cached, m_loader.get(), input_memory, actual.data(),
+                                            count),
+              count);
+    EXPECT_EQ(0, memcmp(expected.data(), actual.data(), count * stride)) << "run " << run;
+    EXPECT_EQ(expected_matrix_indices, VertexLoaderManager::position_matrix_index_cache);
+    EXPECT_EQ(expected_positions, VertexLoaderManager::position_cache);
+    EXPECT_EQ(expected_normal, VertexLoaderManager::normal_cache);
+  }
+  EXPECT_EQ(cached.loader, m_loader.get());
+  EXPECT_EQ(cached.count, count);
+  DisplayListCache::Clear();
+}
+
 // For gtest, which doesn't know about our fmt::formatters by default
 static void PrintTo(const VertexComponentFormat& t, std::ostream* os)
 {